@@ -0,0 +1,121 @@
+// build: clang++ "allocator bench.cpp" -std=c++17 -O2 -l SplashKit -o allocator_bench
+#include "splashkit.h"
+#include "allocators.hpp"
+#include "dynamic array.hpp"
+#include "link_list.hpp"
+#include <chrono>
+#include <string>
+
+// Throughput of churning many small containers with malloc, a node pool
+// and an arena. Each round builds LISTS lists (or arrays), then deletes
+// them all; the arena is reset once per round.
+// usage: ./allocator_bench [rounds]   (default 2000)
+
+const int LISTS = 100;          // containers alive at once
+const int NODES = 64;           // add_node calls per list
+const int HEAD_OPS = 16;        // insert_at(0) + delete_at(0) pairs per list
+const int ARRAY_PUSHES = 64;    // push_back calls per array
+
+volatile long sink;             // keeps the optimiser from dropping the work
+
+enum BenchMode { MODE_MALLOC, MODE_POOL, MODE_ARENA };
+
+double elapsed_ms(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void report(const std::string &name, long ops, double ms)
+{
+    std::string line = name;
+    while (line.size() < 26) line += " ";
+    line += std::to_string(ms) + " ms  " + std::to_string(ops / (ms * 1e3)) + " Mops/s";
+    write_line(line);
+}
+
+// Inserts and deletes on LISTS short lists per round
+void bench_lists(const std::string &name, int rounds, BenchMode mode)
+{
+    Arena arena;
+    Pool pool;
+    init_arena(arena, 64 * 1024);
+    init_node_pool<int>(pool, 1024);
+    Allocator arena_alloc = arena_allocator(arena), pool_alloc = pool_allocator(pool);
+    Allocator *alloc = (mode == MODE_ARENA) ? &arena_alloc : (mode == MODE_POOL) ? &pool_alloc : nullptr;
+
+    linked_list<int> *lists[LISTS];
+    long ops = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (int l = 0; l < LISTS; ++l)
+        {
+            linked_list<int> *list = new_linked_list<int>(alloc);
+            for (int i = 0; i < NODES; ++i) add_node(list, i);
+            for (int i = 0; i < HEAD_OPS; ++i)
+            {
+                insert_at(list, 0, i);
+                delete_at(list, 0);
+            }
+            lists[l] = list;
+        }
+        for (int l = 0; l < LISTS; ++l)
+        {
+            sink += lists[l]->last->data;
+            delete_linked_list(lists[l]);
+        }
+        if (mode == MODE_ARENA) arena_reset(arena);
+        ops += (long) LISTS * (2 * NODES + 2 * HEAD_OPS);   // every node is allocated and freed
+    }
+    report(name, ops, elapsed_ms(t0));
+    free_arena(arena);
+    free_pool(pool);
+}
+
+// push_back into LISTS small arrays per round
+void bench_arrays(const std::string &name, int rounds, BenchMode mode)
+{
+    Arena arena;
+    init_arena(arena, 64 * 1024);
+    Allocator arena_alloc = arena_allocator(arena);
+    Allocator *alloc = (mode == MODE_ARENA) ? &arena_alloc : nullptr;
+
+    DynamicArray<int> arrays[LISTS];
+    long ops = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (int l = 0; l < LISTS; ++l)
+        {
+            init_array(arrays[l], 1, GROW_DOUBLE, alloc);
+            for (int i = 0; i < ARRAY_PUSHES; ++i) push_back(arrays[l], i);
+        }
+        for (int l = 0; l < LISTS; ++l)
+        {
+            sink += get_at(arrays[l], ARRAY_PUSHES - 1);
+            free_array(arrays[l]);
+        }
+        if (mode == MODE_ARENA) arena_reset(arena);
+        ops += (long) LISTS * ARRAY_PUSHES;
+    }
+    report(name, ops, elapsed_ms(t0));
+    free_arena(arena);
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = 2000;
+    if (argc > 1) rounds = std::stoi(argv[1]);
+
+    write_line("linked_list insert/delete, " + std::to_string(rounds) + " rounds of " +
+               std::to_string(LISTS) + " lists");
+    bench_lists("  malloc", rounds, MODE_MALLOC);
+    bench_lists("  node pool", rounds, MODE_POOL);
+    bench_lists("  arena + reset", rounds, MODE_ARENA);
+
+    write_line("DynamicArray<int> push_back, " + std::to_string(rounds) + " rounds of " +
+               std::to_string(LISTS) + " arrays");
+    bench_arrays("  malloc", rounds, MODE_MALLOC);
+    bench_arrays("  arena + reset", rounds, MODE_ARENA);
+    return 0;
+}
@@ -0,0 +1,269 @@
+#ifndef ALLOCATORS_HPP
+#define ALLOCATORS_HPP
+
+#include <cstdlib>      // malloc, realloc, free
+#include <cstddef>      // size_t, std::max_align_t
+#include <cstring>      // memcpy
+
+// Allocator hook shared by DynamicArray and linked_list.
+// A container holding a NULL Allocator* uses malloc / realloc / free.
+// deallocate == NULL means blocks are only freed in bulk (arena reset),
+// so containers may skip walking their blocks on destruction.
+struct Allocator
+{
+    void *state;                                                   // Arena* / Pool* / NULL
+    void *(*allocate)(void *state, size_t bytes);
+    void *(*reallocate)(void *state, void *p, size_t old_bytes, size_t new_bytes);
+    void (*deallocate)(void *state, void *p, size_t bytes);
+};
+
+const size_t ALLOC_ALIGN = alignof(std::max_align_t);
+
+// Round n up to a multiple of ALLOC_ALIGN
+inline size_t align_up(size_t n)
+{
+    return (n + ALLOC_ALIGN - 1) & ~(ALLOC_ALIGN - 1);
+}
+
+// ---------- calls used by the containers ----------
+
+inline void *alloc_bytes(Allocator *a, size_t bytes)
+{
+    return a ? a->allocate(a->state, bytes) : malloc(bytes);
+}
+
+// Grow or shrink a block, keeping its first min(old, new) bytes
+inline void *realloc_bytes(Allocator *a, void *p, size_t old_bytes, size_t new_bytes)
+{
+    if (!a) return realloc(p, new_bytes);
+    if (a->reallocate) return a->reallocate(a->state, p, old_bytes, new_bytes);
+
+    void *q = a->allocate(a->state, new_bytes);
+    if (q == NULL) return NULL;
+    if (p != NULL) memcpy(q, p, (old_bytes < new_bytes) ? old_bytes : new_bytes);
+    if (p != NULL && a->deallocate) a->deallocate(a->state, p, old_bytes);
+    return q;
+}
+
+inline void free_bytes(Allocator *a, void *p, size_t bytes)
+{
+    if (!a) free(p);
+    else if (a->deallocate && p != NULL) a->deallocate(a->state, p, bytes);
+}
+
+// True when freeing blocks one by one is a no-op
+inline bool frees_in_bulk(const Allocator *a)
+{
+    return a != NULL && a->deallocate == NULL;
+}
+
+// ---------- bump-pointer arena ----------
+// Allocation is a pointer bump; nothing is freed until arena_reset,
+// which rewinds to the first block and keeps every block for reuse.
+
+struct ArenaBlock
+{
+    ArenaBlock *next;    // next block in allocation order
+    size_t size;         // usable bytes after the (aligned) header
+};
+
+struct Arena
+{
+    ArenaBlock *first;   // first block, where a reset rewinds to
+    ArenaBlock *current; // block being bumped
+    char *ptr;           // next free byte in current
+    char *end;           // end of current
+    char *last;          // start of the most recent allocation, for in-place realloc
+    size_t block_size;   // default size of new blocks
+};
+
+inline char *arena_block_data(ArenaBlock *b)
+{
+    return (char *) b + align_up(sizeof(ArenaBlock));
+}
+
+// Initialize an empty arena; blocks are malloc'd on demand
+inline void init_arena(Arena &arena, size_t block_size)
+{
+    arena.first = arena.current = NULL;
+    arena.ptr = arena.end = arena.last = NULL;
+    arena.block_size = (block_size > 0) ? block_size : 4096;
+}
+
+// Return NULL only when a new block cannot be malloc'd
+inline void *arena_alloc(Arena &arena, size_t bytes)
+{
+    bytes = align_up(bytes > 0 ? bytes : 1);
+    while ((size_t) (arena.end - arena.ptr) < bytes)
+    {
+        // Reuse the next kept block if it is big enough, else splice in a new one
+        ArenaBlock *next = arena.current ? arena.current->next : arena.first;
+        if (next == NULL || next->size < bytes)
+        {
+            size_t size = (bytes > arena.block_size) ? bytes : arena.block_size;
+            ArenaBlock *b = (ArenaBlock *) malloc(align_up(sizeof(ArenaBlock)) + size);
+            if (b == NULL) return NULL;
+            b->size = size;
+            b->next = next;
+            if (arena.current) arena.current->next = b;
+            else arena.first = b;
+            next = b;
+        }
+        arena.current = next;
+        arena.ptr = arena_block_data(next);
+        arena.end = arena.ptr + next->size;
+    }
+    arena.last = arena.ptr;
+    arena.ptr += bytes;
+    return arena.last;
+}
+
+// The most recent allocation grows or shrinks in place when it fits
+inline void *arena_realloc(Arena &arena, void *p, size_t old_bytes, size_t new_bytes)
+{
+    if (p != NULL && p == arena.last && (size_t) (arena.end - arena.last) >= align_up(new_bytes))
+    {
+        arena.ptr = arena.last + align_up(new_bytes > 0 ? new_bytes : 1);
+        return p;
+    }
+    void *q = arena_alloc(arena, new_bytes);
+    if (q != NULL && p != NULL) memcpy(q, p, (old_bytes < new_bytes) ? old_bytes : new_bytes);
+    return q;
+}
+
+// Drop every allocation at once; the blocks stay for the next round
+inline void arena_reset(Arena &arena)
+{
+    arena.current = NULL;
+    arena.ptr = arena.end = arena.last = NULL;
+}
+
+// Give every block back to malloc
+inline void free_arena(Arena &arena)
+{
+    ArenaBlock *b = arena.first;
+    while (b != NULL)
+    {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+    init_arena(arena, arena.block_size);
+}
+
+inline Allocator arena_allocator(Arena &arena)
+{
+    Allocator a;
+    a.state = &arena;
+    a.allocate = [](void *s, size_t bytes) { return arena_alloc(*(Arena *) s, bytes); };
+    a.reallocate = [](void *s, void *p, size_t old_bytes, size_t new_bytes) {
+        return arena_realloc(*(Arena *) s, p, old_bytes, new_bytes);
+    };
+    a.deallocate = NULL;   // freed by arena_reset
+    return a;
+}
+
+// ---------- fixed-size free-list pool ----------
+// Every slot is slot_size bytes. Freed slots go on an intrusive free list
+// and are handed out again first; pool_reset drops them all at once.
+
+struct PoolSlot
+{
+    PoolSlot *next;      // next free slot
+};
+
+struct Pool
+{
+    size_t slot_size;        // bytes per slot (aligned, >= sizeof(PoolSlot))
+    size_t slots_per_chunk;
+    PoolSlot *free_list;     // freed slots
+    ArenaBlock *first;       // chunks, kept across resets
+    ArenaBlock *current;     // chunk slots are carved from
+    char *ptr;               // next never-used slot in current
+    char *end;
+};
+
+inline void init_pool(Pool &pool, size_t slot_size, size_t slots_per_chunk)
+{
+    if (slot_size < sizeof(PoolSlot)) slot_size = sizeof(PoolSlot);
+    pool.slot_size = align_up(slot_size);
+    pool.slots_per_chunk = (slots_per_chunk > 0) ? slots_per_chunk : 256;
+    pool.free_list = NULL;
+    pool.first = pool.current = NULL;
+    pool.ptr = pool.end = NULL;
+}
+
+// Return a free slot; NULL only when a new chunk cannot be malloc'd
+inline void *pool_alloc(Pool &pool)
+{
+    if (pool.free_list != NULL)
+    {
+        PoolSlot *s = pool.free_list;
+        pool.free_list = s->next;
+        return s;
+    }
+    if (pool.ptr == pool.end)
+    {
+        ArenaBlock *next = pool.current ? pool.current->next : pool.first;
+        if (next == NULL)
+        {
+            size_t size = pool.slot_size * pool.slots_per_chunk;
+            next = (ArenaBlock *) malloc(align_up(sizeof(ArenaBlock)) + size);
+            if (next == NULL) return NULL;
+            next->size = size;
+            next->next = NULL;
+            if (pool.current) pool.current->next = next;
+            else pool.first = next;
+        }
+        pool.current = next;
+        pool.ptr = arena_block_data(next);
+        pool.end = pool.ptr + next->size;
+    }
+    void *p = pool.ptr;
+    pool.ptr += pool.slot_size;
+    return p;
+}
+
+inline void pool_free(Pool &pool, void *p)
+{
+    if (p == NULL) return;
+    PoolSlot *s = (PoolSlot *) p;
+    s->next = pool.free_list;
+    pool.free_list = s;
+}
+
+// Drop every slot at once; the chunks stay for reuse
+inline void pool_reset(Pool &pool)
+{
+    pool.free_list = NULL;
+    pool.current = NULL;
+    pool.ptr = pool.end = NULL;
+}
+
+inline void free_pool(Pool &pool)
+{
+    ArenaBlock *b = pool.first;
+    while (b != NULL)
+    {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+    init_pool(pool, pool.slot_size, pool.slots_per_chunk);
+}
+
+// Allocator handing out pool slots; only for requests of at most slot_size bytes
+inline Allocator pool_allocator(Pool &pool)
+{
+    Allocator a;
+    a.state = &pool;
+    a.allocate = [](void *s, size_t bytes) {
+        Pool &pool = *(Pool *) s;
+        return (bytes <= pool.slot_size) ? pool_alloc(pool) : (void *) NULL;
+    };
+    a.reallocate = NULL;
+    a.deallocate = [](void *s, void *p, size_t) { pool_free(*(Pool *) s, p); };
+    return a;
+}
+
+#endif // ALLOCATORS_HPP
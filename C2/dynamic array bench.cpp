@@ -0,0 +1,128 @@
+// build: clang++ "dynamic array bench.cpp" -std=c++17 -O2 -l SplashKit -o bench
+#include "splashkit.h"
+#include "dynamic array.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Microbenchmark: DynamicArray<T> against std::vector<T>
+// usage: ./bench [elements]   (default 10000000)
+
+const int REPEATS = 5;          // best of this many runs is reported
+const size_t CHUNK = 1000;      // elements per append() call
+const size_t STRING_DIVISOR = 10; // string runs use elements / this
+
+volatile size_t sink;           // keeps the optimiser from dropping the work
+
+// Milliseconds taken by the fastest of REPEATS calls to `run`
+template <typename F>
+double best_ms(F run)
+{
+    double best = 1e300;
+    for (int r = 0; r < REPEATS; ++r)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        run();
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+void report(const std::string &name, size_t n, double ms, long regrows)
+{
+    std::string line = name;
+    while (line.size() < 34) line += " ";
+    line += std::to_string(ms) + " ms  " + std::to_string(ms * 1e6 / (double) n) + " ns/elem";
+    if (regrows >= 0) line += "  regrows " + std::to_string(regrows);
+    write_line(line);
+}
+
+// push_back n copies of make(i), counting how often the capacity changed
+template <typename T, typename Make>
+void bench_dynamic(const std::string &name, size_t n, GrowthPolicy growth, bool reserved, Make make)
+{
+    long regrows = 0;
+    double ms = best_ms([&]() {
+        DynamicArray<T> arr;
+        init_array(arr, 1, growth);
+        if (reserved) reserve(arr, n);
+        regrows = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t before = arr.capacity;
+            push_back(arr, make(i));
+            regrows += arr.capacity != before;
+        }
+        sink = arr.size;
+        free_array(arr);
+    });
+    report(name, n, ms, regrows);
+}
+
+template <typename T, typename Make>
+void bench_vector(const std::string &name, size_t n, bool reserved, Make make)
+{
+    double ms = best_ms([&]() {
+        std::vector<T> v;
+        if (reserved) v.reserve(n);
+        for (size_t i = 0; i < n; ++i) v.push_back(make(i));
+        sink = v.size();
+    });
+    report(name, n, ms, -1);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = 10000000;
+    if (argc > 1) n = (size_t) std::stoull(argv[1]);
+    if (n < CHUNK) n = CHUNK;
+
+    auto make_int = [](size_t i) { return (int) i; };
+    write_line("push_back int x " + std::to_string(n));
+    bench_dynamic<int>("  DynamicArray 2x", n, GROW_DOUBLE, false, make_int);
+    bench_dynamic<int>("  DynamicArray 1.5x", n, GROW_HALF, false, make_int);
+    bench_dynamic<int>("  DynamicArray reserved", n, GROW_DOUBLE, true, make_int);
+    bench_vector<int>("  std::vector", n, false, make_int);
+    bench_vector<int>("  std::vector reserved", n, true, make_int);
+
+    // Long enough to defeat the small-string buffer, so every regrow
+    // has to move real heap-owning objects
+    const size_t ns = n / STRING_DIVISOR;
+    auto make_string = [](size_t i) { return std::string("element number ") + std::to_string(i); };
+    write_line("push_back std::string x " + std::to_string(ns));
+    bench_dynamic<std::string>("  DynamicArray 2x", ns, GROW_DOUBLE, false, make_string);
+    bench_dynamic<std::string>("  DynamicArray 1.5x", ns, GROW_HALF, false, make_string);
+    bench_dynamic<std::string>("  DynamicArray reserved", ns, GROW_DOUBLE, true, make_string);
+    bench_vector<std::string>("  std::vector", ns, false, make_string);
+    bench_vector<std::string>("  std::vector reserved", ns, true, make_string);
+
+    std::vector<int> chunk(CHUNK);
+    for (size_t i = 0; i < CHUNK; ++i) chunk[i] = (int) i;
+    const size_t chunks = n / CHUNK;
+    write_line("append " + std::to_string(CHUNK) + " int x " + std::to_string(chunks));
+    long regrows = 0;
+    double ms = best_ms([&]() {
+        DynamicArray<int> arr;
+        init_array(arr, 1);
+        regrows = 0;
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            size_t before = arr.capacity;
+            append(arr, chunk.data(), CHUNK);
+            regrows += arr.capacity != before;
+        }
+        sink = arr.size;
+        free_array(arr);
+    });
+    report("  DynamicArray append", chunks * CHUNK, ms, regrows);
+    ms = best_ms([&]() {
+        std::vector<int> v;
+        for (size_t c = 0; c < chunks; ++c) v.insert(v.end(), chunk.begin(), chunk.end());
+        sink = v.size();
+    });
+    report("  std::vector insert", chunks * CHUNK, ms, -1);
+
+    return 0;
+}
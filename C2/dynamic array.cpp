@@ -3,7 +3,7 @@
 
 int main()
 {
-    DynamicArray arr;
+    DynamicArray<int> arr;
 
     // Initialize array with capacity 2
     init_array(arr, 2);
@@ -2,23 +2,68 @@
 #define DYNAMIC_ARRAY_HPP
 
 #include "splashkit.h"
+#include "allocators.hpp"
 #include <cstdlib>      // for size_t
-#include <iostream>     // indirectly includes <new> for std::nothrow
+#include <cstring>      // for memcpy
+#include <iterator>     // for std::begin, std::end, std::distance
+#include <new>          // for placement new
+#include <type_traits>
+#include <utility>      // for std::move, std::forward
 
-// Dynamic array structure (stores only int)
+// How much capacity grows by when the array is full
+enum GrowthPolicy
+{
+    GROW_DOUBLE,     // 2x: fewer regrows
+    GROW_HALF        // 1.5x: less slack, old blocks can be reused by the allocator
+};
+
+// Dynamic array structure (stores any T)
+template <typename T>
 struct DynamicArray
 {
-    int *data;       // Pointer to array data
-    size_t size;     // Current number of elements
-    size_t capacity; // Allocated capacity
+    T *data;             // Pointer to array data (raw storage, first `size` slots constructed)
+    size_t size;         // Current number of elements
+    size_t capacity;     // Allocated capacity
+    GrowthPolicy growth; // Used by push_back / emplace_back / append when full
+    Allocator *alloc;    // Where the storage comes from (NULL = malloc)
 };
 
+// Trivially copyable elements are moved with memcpy / realloc,
+// everything else is move-constructed into the new block
+template <typename T>
+constexpr bool relocate_by_memcpy()
+{
+    return std::is_trivially_copyable<T>::value;
+}
+
+// Move `count` constructed elements from `from` into raw storage `to`
+// and destroy the originals
+template <typename T>
+void relocate_elements(T *to, T *from, size_t count)
+{
+    if constexpr (relocate_by_memcpy<T>())
+    {
+        if (count > 0) memcpy((void *) to, (const void *) from, count * sizeof(T));
+        return;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        new (to + i) T(std::move_if_noexcept(from[i]));
+        from[i].~T();
+    }
+}
+
 // Initialize the dynamic array
-void init_array(DynamicArray &arr, size_t initial_capacity)
+template <typename T>
+void init_array(DynamicArray<T> &arr, size_t initial_capacity, GrowthPolicy growth = GROW_DOUBLE,
+                Allocator *alloc = NULL)
 {
+    static_assert(alignof(T) <= ALLOC_ALIGN, "DynamicArray storage is only max_align_t aligned");
     arr.size = 0;
+    arr.growth = growth;
+    arr.alloc = alloc;
     arr.capacity = (initial_capacity > 0) ? initial_capacity : 1;
-    arr.data = new (std::nothrow) int[arr.capacity];
+    arr.data = (T *) alloc_bytes(alloc, arr.capacity * sizeof(T));
 
     if (arr.data == NULL)
     {
@@ -28,58 +73,190 @@ void init_array(DynamicArray &arr, size_t initial_capacity)
 }
 
 // Free the memory of the dynamic array
-void free_array(DynamicArray &arr)
+template <typename T>
+void free_array(DynamicArray<T> &arr)
 {
-    delete[] arr.data;
+    for (size_t i = 0; i < arr.size; ++i) arr.data[i].~T();
+    free_bytes(arr.alloc, arr.data, arr.capacity * sizeof(T));
     arr.data = NULL;
     arr.size = 0;
     arr.capacity = 0;
 }
 
-// Resize the array (called when capacity is insufficient)
-bool resize_array(DynamicArray &arr, size_t new_capacity)
+// Move the elements into a block of exactly `new_capacity` slots
+// (new_capacity must be >= size)
+template <typename T>
+bool reallocate_array(DynamicArray<T> &arr, size_t new_capacity)
 {
-    if (new_capacity <= arr.capacity) return true;
+    if (new_capacity == arr.capacity) return true;
+    if (new_capacity == 0)
+    {
+        free_bytes(arr.alloc, arr.data, arr.capacity * sizeof(T));
+        arr.data = NULL;
+        arr.capacity = 0;
+        return true;
+    }
 
-    int *new_data = new (std::nothrow) int[new_capacity];
+    T *new_data;
+    if constexpr (relocate_by_memcpy<T>())
+    {
+        // realloc may grow in place and skip the copy altogether
+        new_data = (T *) realloc_bytes(arr.alloc, (void *) arr.data,
+                                       arr.capacity * sizeof(T), new_capacity * sizeof(T));
+    }
+    else
+    {
+        new_data = (T *) alloc_bytes(arr.alloc, new_capacity * sizeof(T));
+        if (new_data != NULL)
+        {
+            relocate_elements(new_data, arr.data, arr.size);
+            free_bytes(arr.alloc, arr.data, arr.capacity * sizeof(T));
+        }
+    }
     if (new_data == NULL)
     {
         write_line("Memory allocation failed during resize_array!");
         return false;
     }
 
-    // Copy old data
-    for (size_t i = 0; i < arr.size; ++i)
+    arr.data = new_data;
+    arr.capacity = new_capacity;
+    return true;
+}
+
+// Resize the array (called when capacity is insufficient)
+template <typename T>
+bool resize_array(DynamicArray<T> &arr, size_t new_capacity)
+{
+    if (new_capacity <= arr.capacity) return true;
+    return reallocate_array(arr, new_capacity);
+}
+
+// Make room for at least `min_capacity` elements without further regrows
+template <typename T>
+bool reserve(DynamicArray<T> &arr, size_t min_capacity)
+{
+    return resize_array(arr, min_capacity);
+}
+
+// Give back the unused capacity
+template <typename T>
+bool shrink_to_fit(DynamicArray<T> &arr)
+{
+    return reallocate_array(arr, arr.size);
+}
+
+// Capacity to grow to when `needed` elements must fit
+template <typename T>
+size_t grown_capacity(const DynamicArray<T> &arr, size_t needed)
+{
+    size_t next = (arr.growth == GROW_HALF) ? arr.capacity + arr.capacity / 2 : arr.capacity * 2;
+    if (next <= arr.capacity) next = arr.capacity + 1;   // capacity 0 or 1
+    return (next < needed) ? needed : next;
+}
+
+// Construct an element in place at the end of the array
+template <typename T, typename... Args>
+bool emplace_back(DynamicArray<T> &arr, Args &&...args)
+{
+    if (arr.size < arr.capacity)
     {
-        new_data[i] = arr.data[i];
+        new (arr.data + arr.size) T(std::forward<Args>(args)...);
+        ++arr.size;
+        return true;
     }
 
-    delete[] arr.data;
-    arr.data = new_data;
-    arr.capacity = new_capacity;
+    // The arguments may refer to an element of this array,
+    // so build the new element before the old block goes away
+    const size_t new_capacity = grown_capacity(arr, arr.size + 1);
+    if constexpr (relocate_by_memcpy<T>())
+    {
+        T value(std::forward<Args>(args)...);
+        if (!reallocate_array(arr, new_capacity)) return false;
+        new (arr.data + arr.size) T(std::move(value));
+    }
+    else
+    {
+        T *new_data = (T *) alloc_bytes(arr.alloc, new_capacity * sizeof(T));
+        if (new_data == NULL)
+        {
+            write_line("Memory allocation failed during resize_array!");
+            return false;
+        }
+        new (new_data + arr.size) T(std::forward<Args>(args)...);
+        relocate_elements(new_data, arr.data, arr.size);
+        free_bytes(arr.alloc, arr.data, arr.capacity * sizeof(T));
+        arr.data = new_data;
+        arr.capacity = new_capacity;
+    }
+    ++arr.size;
     return true;
 }
 
 // Add an element to the end of the array
-bool push_back(DynamicArray &arr, int value)
+template <typename T>
+bool push_back(DynamicArray<T> &arr, const T &value)
 {
-    if (arr.size >= arr.capacity)
+    return emplace_back(arr, value);
+}
+
+template <typename T>
+bool push_back(DynamicArray<T> &arr, T &&value)
+{
+    return emplace_back(arr, std::move(value));
+}
+
+// Copy `count` elements starting at `first` to the end of the array,
+// growing at most once
+template <typename T>
+bool append(DynamicArray<T> &arr, const T *first, size_t count)
+{
+    if (count == 0) return true;
+
+    // Appending part of the array to itself: remember where it was
+    const bool self = first >= arr.data && first < arr.data + arr.size;
+    const size_t offset = self ? (size_t) (first - arr.data) : 0;
+
+    if (arr.size + count > arr.capacity)
     {
-        if (!resize_array(arr, arr.capacity * 2))
-            return false;
+        if (!reallocate_array(arr, grown_capacity(arr, arr.size + count))) return false;
+        if (self) first = arr.data + offset;
+    }
+
+    if constexpr (relocate_by_memcpy<T>())
+    {
+        memcpy((void *) (arr.data + arr.size), (const void *) first, count * sizeof(T));
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i) new (arr.data + arr.size + i) T(first[i]);
     }
-    arr.data[arr.size++] = value;
+    arr.size += count;
+    return true;
+}
+
+// Append every element of a container or built-in array
+template <typename T, typename Range>
+bool append(DynamicArray<T> &arr, const Range &range)
+{
+    auto first = std::begin(range), last = std::end(range);
+    const size_t count = (size_t) std::distance(first, last);
+    if (arr.size + count > arr.capacity &&
+        !reallocate_array(arr, grown_capacity(arr, arr.size + count))) return false;
+    for (; first != last; ++first) new (arr.data + arr.size++) T(*first);
     return true;
 }
 
 // Get the element at the specified index (no bounds checking)
-int get_at(const DynamicArray &arr, size_t index)
+template <typename T>
+const T &get_at(const DynamicArray<T> &arr, size_t index)
 {
     return arr.data[index];
 }
 
 // Set the element at the specified index (no bounds checking)
-void set_at(DynamicArray &arr, size_t index, int value)
+template <typename T>
+void set_at(DynamicArray<T> &arr, size_t index, const T &value)
 {
     arr.data[index] = value;
 }
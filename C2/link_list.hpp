@@ -0,0 +1,182 @@
+#ifndef LINK_LIST_HPP
+#define LINK_LIST_HPP
+
+#include <cstdio>
+#include <cstdlib>   // free
+#include <iostream>
+#include "allocators.hpp"   // Allocator hook, arena, node pool
+
+// Node structure
+template <typename T>
+struct node
+{
+    T data;          // stored value
+    node<T> *next;   // pointer to next node
+};
+
+// Linked list structure (head and tail)
+template <typename T>
+struct linked_list
+{
+    node<T> *first;  // pointer to first node
+    node<T> *last;   // pointer to last node
+    Allocator *alloc; // where the list and its nodes live (NULL = malloc)
+};
+
+// Set up a pool whose slots fit exactly one node<T>
+template <typename T>
+void init_node_pool(Pool &pool, size_t nodes_per_chunk)
+{
+    init_pool(pool, sizeof(node<T>), nodes_per_chunk);
+}
+
+// Allocate and initialize a new linked list whose nodes come from `alloc`
+// (an arena or node pool), or malloc when NULL. With an arena the list
+// itself lives there too, so resetting the arena frees everything.
+template <typename T>
+linked_list<T> *new_linked_list(Allocator *alloc = nullptr)
+{
+    Allocator *home = frees_in_bulk(alloc) ? alloc : nullptr;
+    linked_list<T> *list = (linked_list<T> *) alloc_bytes(home, sizeof(linked_list<T>));
+    list->first = nullptr;
+    list->last = nullptr;
+    list->alloc = alloc;
+    return list;
+}
+
+// A node's storage comes from the list's allocator
+template <typename T>
+node<T> *alloc_node(linked_list<T> *list)
+{
+    return (node<T> *) alloc_bytes(list->alloc, sizeof(node<T>));
+}
+
+template <typename T>
+void free_node(linked_list<T> *list, node<T> *n)
+{
+    free_bytes(list->alloc, n, sizeof(node<T>));
+}
+
+// Append a node with value `data` to the tail of the list
+template <typename T>
+void add_node(linked_list<T> *list, T data)
+{
+    node<T> *new_node = alloc_node(list);
+    new_node->data = data;
+    new_node->next = nullptr;
+
+    if (list->first == nullptr) // empty list
+    {
+        list->first = new_node;
+        list->last = new_node;
+    }
+    else
+    {
+        list->last->next = new_node;
+        list->last = new_node;
+    }
+}
+
+// Insert a node with value `data` at position `position` (0-based).
+// If position <= 0, insert at head. If position >= length, insert at tail.
+template <typename T>
+void insert_at(linked_list<T> *list, int position, T data)
+{
+    node<T> *new_node = alloc_node(list);
+    new_node->data = data;
+    new_node->next = nullptr;
+
+    if (position <= 0 || list->first == nullptr)
+    {
+        new_node->next = list->first;
+        list->first = new_node;
+        if (list->last == nullptr)
+            list->last = new_node;
+        return;
+    }
+
+    node<T> *current = list->first;
+    int index = 0;
+    while (current->next != nullptr && index < position - 1)
+    {
+        current = current->next;
+        index++;
+    }
+
+    new_node->next = current->next;
+    current->next = new_node;
+
+    if (new_node->next == nullptr)
+        list->last = new_node;
+}
+
+// Delete node at position `position` (0-based).
+// If position <= 0, delete head. If position out of range, no-op.
+template <typename T>
+void delete_at(linked_list<T> *list, int position)
+{
+    if (list->first == nullptr) return; // empty
+
+    node<T> *to_delete = nullptr;
+
+    if (position <= 0)
+    {
+        to_delete = list->first;
+        list->first = list->first->next;
+        if (list->first == nullptr)
+            list->last = nullptr;
+        free_node(list, to_delete);
+        return;
+    }
+
+    node<T> *current = list->first;
+    int index = 0;
+    while (current->next != nullptr && index < position - 1)
+    {
+        current = current->next;
+        index++;
+    }
+
+    if (current->next == nullptr) return; // out of range
+
+    to_delete = current->next;
+    current->next = to_delete->next;
+    if (to_delete == list->last)
+        list->last = current;
+    free_node(list, to_delete);
+}
+
+// Print all elements from head to tail
+template <typename T>
+void traverse_list(linked_list<T> *list)
+{
+    node<T> *current = list->first;
+    while (current != nullptr)
+    {
+        std::cout << current->data << " ";
+        current = current->next;
+    }
+    std::cout << std::endl;
+}
+
+// Free every node and then free the list container itself.
+// With an arena nothing is walked: the owner frees it all with arena_reset.
+template <typename T>
+void delete_linked_list(linked_list<T> *list)
+{
+    Allocator *alloc = list->alloc;
+    if (frees_in_bulk(alloc)) return;
+
+    node<T> *current = list->first;
+    while (current != nullptr)
+    {
+        node<T> *next = current->next;
+        free_node(list, current);
+        current = next;
+    }
+    list->first = nullptr;
+    list->last = nullptr;
+    free(list);
+}
+
+#endif // LINK_LIST_HPP
@@ -0,0 +1,138 @@
+// build: clang++ "unrolled list bench.cpp" -std=c++17 -O2 -l SplashKit -o unrolled_bench
+#include "splashkit.h"
+#include "link_list.hpp"
+#include "unrolled_list.hpp"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// Random positional edits on unrolled_list<int, B> against the
+// node-per-element linked_list, then a correctness run of both block sizes
+// against a std::vector reference.
+// usage: ./unrolled_bench [elements] [edit pairs]   (default 300000, 200000)
+
+const int LINKED_PAIRS = 2000;  // the linked list walks O(n) per edit: far fewer pairs
+const int CHECK_EDITS = 200000; // random edits per correctness run
+const int CHECK_SIZE = 5000;    // elements the correctness runs start from
+
+volatile long sink;             // keeps the optimiser from dropping the work
+
+double elapsed_ms(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void report(const std::string &name, long ops, double ms)
+{
+    std::string line = name;
+    while (line.size() < 26) line += " ";
+    line += std::to_string(ms) + " ms  " + std::to_string(ms * 1e6 / (double) ops) + " ns/op";
+    write_line(line);
+}
+
+// `pairs` insert_at + delete_at at random positions on an n-element list
+template <int B>
+void bench_unrolled(const std::string &name, int n, int pairs)
+{
+    unrolled_list<int, B> *list = new_unrolled_list<int, B>();
+    for (int i = 0; i < n; ++i) add_node(list, i);
+    std::mt19937 rng(1);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < pairs; ++i)
+    {
+        insert_at(list, (int) (rng() % (n + 1)), i);
+        delete_at(list, (int) (rng() % (n + 1)));
+    }
+    double ms = elapsed_ms(t0);
+    sink += get_at(list, n / 2);
+    report(name, 2L * pairs, ms);
+    delete_unrolled_list(list);
+}
+
+void bench_linked(const std::string &name, int n, int pairs)
+{
+    linked_list<int> *list = new_linked_list<int>();
+    for (int i = 0; i < n; ++i) add_node(list, i);
+    std::mt19937 rng(1);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < pairs; ++i)
+    {
+        insert_at(list, (int) (rng() % (n + 1)), i);
+        delete_at(list, (int) (rng() % (n + 1)));
+    }
+    double ms = elapsed_ms(t0);
+    sink += list->last->data;
+    report(name, 2L * pairs, ms);
+    delete_linked_list(list);
+}
+
+// Random inserts, deletes and reads, out-of-range positions included, mirrored
+// on a std::vector with the same clamping rules. Returns the mismatches found.
+template <int B>
+long check_against_vector(unsigned seed)
+{
+    unrolled_list<int, B> *list = new_unrolled_list<int, B>();
+    std::vector<int> ref;
+    for (int i = 0; i < CHECK_SIZE; ++i)
+    {
+        add_node(list, i);
+        ref.push_back(i);
+    }
+    std::mt19937 rng(seed);
+    long mismatches = 0;
+    for (int i = 0; i < CHECK_EDITS; ++i)
+    {
+        const int size = (int) ref.size();
+        const int position = (int) (rng() % (size + 3)) - 1;   // -1 .. size+1
+        // shrink and regrow in phases so blocks split, drain and merge
+        const bool shrinking = (i / 20000) % 2 == 1;
+        if (rng() % 100 < (shrinking ? 30u : 55u))
+        {
+            insert_at(list, position, i);
+            ref.insert(ref.begin() + std::min(std::max(position, 0), size), i);
+        }
+        else
+        {
+            delete_at(list, position);
+            if (size > 0 && position < size) ref.erase(ref.begin() + std::max(position, 0));
+        }
+        if (list->size != (int) ref.size()) mismatches++;
+        else if (!ref.empty())
+        {
+            const int probe = (int) (rng() % ref.size());
+            if (get_at(list, probe) != ref[probe]) mismatches++;
+        }
+    }
+
+    // full walk through the block chain at the end
+    size_t k = 0;
+    for (unrolled_block<int, B> *block = list->blocks.empty() ? nullptr : list->blocks[0]; block; block = block->next)
+        for (int i = 0; i < block->count; ++i, ++k)
+            if (k >= ref.size() || block->items[i] != ref[k]) mismatches++;
+    if (k != ref.size()) mismatches++;
+
+    delete_unrolled_list(list);
+    return mismatches;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = (argc > 1) ? std::stoi(argv[1]) : 300000;
+    int pairs = (argc > 2) ? std::stoi(argv[2]) : 200000;
+    if (n <= 0 || pairs <= 0)
+    {
+        write_line("usage: ./unrolled_bench [elements] [edit pairs]");
+        return 1;
+    }
+
+    write_line(std::to_string(n) + " elements, random insert_at + delete_at pairs");
+    bench_unrolled<64>("unrolled_list B=64", n, pairs);
+    bench_unrolled<16>("unrolled_list B=16", n, pairs);
+    bench_linked("linked_list", n, std::min(pairs, LINKED_PAIRS));
+
+    const long bad4 = check_against_vector<4>(7), bad64 = check_against_vector<64>(7);
+    write_line(std::to_string(CHECK_EDITS) + " random edits against std::vector: "
+               + std::to_string(bad4) + " mismatches (B=4), " + std::to_string(bad64) + " (B=64)");
+    return (bad4 || bad64) ? 1 : 0;
+}
@@ -0,0 +1,257 @@
+#ifndef UNROLLED_LIST_HPP
+#define UNROLLED_LIST_HPP
+
+#include <cstring>       // memmove, memcpy
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include "allocators.hpp"   // Allocator hook, arena, pool
+
+// Unrolled linked list: each block holds up to B elements, and a skip index
+// (the block order plus a Fenwick tree of block fill counts) finds the block
+// holding any position in O(log blocks). Edits shift at most B elements, so
+// insert_at / delete_at cost O(log n + B) instead of an O(n) walk.
+
+// Block of up to B elements; blocks are also chained through `next`
+template <typename T, int B>
+struct unrolled_block
+{
+    T items[B];                  // items[0 .. count-1] are in use
+    int count;                   // fill counter
+    unrolled_block<T, B> *next;  // next block, for streaming traversal
+};
+
+template <typename T, int B = 64>
+struct unrolled_list
+{
+    static_assert(std::is_trivially_copyable<T>::value, "blocks shift elements with memmove");
+    static_assert(B >= 4, "blocks need room to split and merge");
+
+    std::vector<unrolled_block<T, B> *> blocks;  // skip index: blocks in list order
+    std::vector<int> fenwick;                    // 1-based Fenwick tree of block counts
+    int size;                                    // total number of elements
+    Allocator *alloc;                            // where blocks live (NULL = malloc)
+};
+
+// ---------- skip index ----------
+
+// Recompute the Fenwick tree after blocks were added, removed or merged
+template <typename T, int B>
+void rebuild_index(unrolled_list<T, B> *list)
+{
+    const int n = (int) list->blocks.size();
+    list->fenwick.assign(n + 1, 0);
+    for (int i = 1; i <= n; ++i)
+    {
+        list->fenwick[i] += list->blocks[i - 1]->count;
+        int parent = i + (i & -i);
+        if (parent <= n) list->fenwick[parent] += list->fenwick[i];
+    }
+}
+
+// Add `delta` to the count recorded for block `b` (0-based)
+template <typename T, int B>
+void index_add(unrolled_list<T, B> *list, int b, int delta)
+{
+    const int n = (int) list->blocks.size();
+    for (int i = b + 1; i <= n; i += i & -i) list->fenwick[i] += delta;
+}
+
+// Block holding `position` (0 <= position < size) and the offset inside it
+template <typename T, int B>
+int find_block(const unrolled_list<T, B> *list, int position, int &offset)
+{
+    const int n = (int) list->blocks.size();
+    int b = 0, step = 1;
+    while (step * 2 <= n) step *= 2;
+    for (; step > 0; step /= 2)
+    {
+        // descend while the blocks before b + step end at or before position
+        if (b + step <= n && list->fenwick[b + step] <= position)
+        {
+            b += step;
+            position -= list->fenwick[b];
+        }
+    }
+    offset = position;
+    return b;
+}
+
+// ---------- blocks ----------
+
+template <typename T, int B>
+unrolled_block<T, B> *new_block(unrolled_list<T, B> *list)
+{
+    unrolled_block<T, B> *block = (unrolled_block<T, B> *) alloc_bytes(list->alloc, sizeof(unrolled_block<T, B>));
+    block->count = 0;
+    block->next = nullptr;
+    return block;
+}
+
+// Put `block` at index position `at` and relink its neighbours
+template <typename T, int B>
+void link_block(unrolled_list<T, B> *list, int at, unrolled_block<T, B> *block)
+{
+    list->blocks.insert(list->blocks.begin() + at, block);
+    block->next = (at + 1 < (int) list->blocks.size()) ? list->blocks[at + 1] : nullptr;
+    if (at > 0) list->blocks[at - 1]->next = block;
+}
+
+// Drop block `b` from the index and free it
+template <typename T, int B>
+void unlink_block(unrolled_list<T, B> *list, int b)
+{
+    unrolled_block<T, B> *block = list->blocks[b];
+    if (b > 0) list->blocks[b - 1]->next = block->next;
+    list->blocks.erase(list->blocks.begin() + b);
+    free_bytes(list->alloc, block, sizeof(unrolled_block<T, B>));
+}
+
+// Move the upper half of full block `b` into a new block after it
+template <typename T, int B>
+void split_block(unrolled_list<T, B> *list, int b)
+{
+    unrolled_block<T, B> *block = list->blocks[b];
+    unrolled_block<T, B> *upper = new_block(list);
+    const int keep = block->count / 2;
+    upper->count = block->count - keep;
+    memcpy(upper->items, block->items + keep, upper->count * sizeof(T));
+    block->count = keep;
+    link_block(list, b + 1, upper);
+    rebuild_index(list);
+}
+
+// ---------- list operations ----------
+
+// Allocate and initialize a new unrolled list; blocks come from `alloc`
+// (an arena or a pool sized to unrolled_block<T, B>), or malloc when NULL
+template <typename T, int B = 64>
+unrolled_list<T, B> *new_unrolled_list(Allocator *alloc = nullptr)
+{
+    unrolled_list<T, B> *list = new unrolled_list<T, B>;
+    list->size = 0;
+    list->alloc = alloc;
+    list->fenwick.assign(1, 0);
+    return list;
+}
+
+// Element at `position` (0-based, no bounds checking)
+template <typename T, int B>
+T &get_at(unrolled_list<T, B> *list, int position)
+{
+    int offset;
+    int b = find_block(list, position, offset);
+    return list->blocks[b]->items[offset];
+}
+
+// Insert `data` at `position` (0-based).
+// If position <= 0, insert at head. If position >= length, insert at tail.
+template <typename T, int B>
+void insert_at(unrolled_list<T, B> *list, int position, T data)
+{
+    if (list->blocks.empty())
+    {
+        link_block(list, 0, new_block(list));
+        rebuild_index(list);
+    }
+    if (position < 0) position = 0;
+
+    int b, offset;
+    if (position >= list->size)
+    {
+        b = (int) list->blocks.size() - 1;
+        offset = list->blocks[b]->count;
+    }
+    else
+    {
+        b = find_block(list, position, offset);
+    }
+
+    if (list->blocks[b]->count == B)
+    {
+        split_block(list, b);
+        const int lower = list->blocks[b]->count;
+        if (offset > lower)
+        {
+            ++b;
+            offset -= lower;
+        }
+    }
+
+    unrolled_block<T, B> *block = list->blocks[b];
+    memmove(block->items + offset + 1, block->items + offset, (block->count - offset) * sizeof(T));
+    block->items[offset] = data;
+    block->count++;
+    list->size++;
+    index_add(list, b, +1);
+}
+
+// Append `data` to the tail of the list
+template <typename T, int B>
+void add_node(unrolled_list<T, B> *list, T data)
+{
+    insert_at(list, list->size, data);
+}
+
+// Delete the element at `position` (0-based).
+// If position <= 0, delete head. If position out of range, no-op.
+template <typename T, int B>
+void delete_at(unrolled_list<T, B> *list, int position)
+{
+    if (list->size == 0 || position >= list->size) return;
+    if (position < 0) position = 0;
+
+    int offset;
+    const int b = find_block(list, position, offset);
+    unrolled_block<T, B> *block = list->blocks[b];
+    memmove(block->items + offset, block->items + offset + 1, (block->count - offset - 1) * sizeof(T));
+    block->count--;
+    list->size--;
+
+    unrolled_block<T, B> *next = block->next;
+    if (block->count == 0)
+    {
+        unlink_block(list, b);
+        rebuild_index(list);
+    }
+    else if (next != nullptr && block->count < B / 4 && block->count + next->count <= B / 2)
+    {
+        // pull the next block in when both fit in half a block. Not a fill
+        // guarantee: a sparse block whose neighbour is too full to absorb stays sparse
+        memcpy(block->items + block->count, next->items, next->count * sizeof(T));
+        block->count += next->count;
+        unlink_block(list, b + 1);
+        rebuild_index(list);
+    }
+    else
+    {
+        index_add(list, b, -1);
+    }
+}
+
+// Print all elements from head to tail, one block at a time
+template <typename T, int B>
+void traverse_list(unrolled_list<T, B> *list)
+{
+    unrolled_block<T, B> *block = list->blocks.empty() ? nullptr : list->blocks[0];
+    for (; block != nullptr; block = block->next)
+    {
+        for (int i = 0; i < block->count; ++i) std::cout << block->items[i] << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Free every block and then the list itself.
+// With an arena the blocks are left for arena_reset.
+template <typename T, int B>
+void delete_unrolled_list(unrolled_list<T, B> *list)
+{
+    if (!frees_in_bulk(list->alloc))
+    {
+        for (unrolled_block<T, B> *block : list->blocks)
+            free_bytes(list->alloc, block, sizeof(unrolled_block<T, B>));
+    }
+    delete list;
+}
+
+#endif // UNROLLED_LIST_HPP
@@ -1,5 +1,6 @@
 #include "splashkit.h"
 #include "utilities.h"
+#include "frame_pacing.h"
 
 // Reads the number of targets from the player.
 // The input value is stored in loop and determines how many targets must be hit.
@@ -88,7 +89,8 @@ void game_over_screen(int best_time)
 // - Reads the number of targets
 // - Opens the game window
 // - Runs the main loop until all targets are hit or quit is requested
-// - Handles spawning, drawing, mouse clicks, penalties, and timing
+// - Handles spawning, drawing, mouse clicks, penalties, and timing; a frame
+//   is drawn only when the target or the info text changed
 // - Ends with the game over screen
 int main()
 {
@@ -99,38 +101,63 @@ int main()
     bool need_new_target = true; // Flag to control target spawning
     int best_time = -1;        // Best reaction time (-1 means no hits yet)
     int current_time = 0;      // Time counter for current target
+    double shown_at = -1;      // When the current target first reached the screen (ms)
+    double next_tick = -1;     // Next 50 ms penalty step (ms)
 
     input_target_count(loop);
     open_window("Reaction Game", 800, 600);
+    frame_pacer pacer;         // Redraw only on change, sleep in between
 
     while (loop > 0 && !quit_requested())
     {
-        process_events();
-        clear_screen(COLOR_WHITE);
-
-        draw_info(loop, best_time);
-
         if (need_new_target)
         {
             spawn_target(x, y, r, init_r, current_time, need_new_target);
+            pacer.dirty = true;
+            shown_at = -1;
+        }
+
+        if (pacer.dirty)
+        {
+            clear_screen(COLOR_WHITE);
+            draw_info(loop, best_time);
+            fill_circle(COLOR_RED, x, y, r);
+            present_frame(pacer);
+
+            // Reaction time counts from the frame that showed the target
+            if (shown_at < 0)
+            {
+                shown_at = pacer_now_ms(pacer);
+                next_tick = shown_at + 50;
+            }
         }
 
-        fill_circle(COLOR_RED, x, y, r);
+        // Sleep until a click or the next penalty step
+        wait_for_events(pacer, next_tick);
 
         if (mouse_clicked(LEFT_BUTTON))
         {
             mx = mouse_x();
             my = mouse_y();
+            // Measured on the clock up to the poll that saw the click, not in 50 ms frames
+            current_time = (int)(pacer_ms(pacer, pacer.last_poll) - shown_at);
             handle_mouse_click(mx, my, x, y, r, loop, best_time, current_time, need_new_target);
+            note_input(pacer);   // A hit spawns a new target, a miss grows this one
         }
 
-        timeout_penalty(current_time, r);
-
-        refresh_screen(50);
-        current_time += 50;
+        // The penalty keeps its old 50 ms steps, now taken from the clock
+        while (!need_new_target && pacer_now_ms(pacer) >= next_tick)
+        {
+            current_time = (int)(next_tick - shown_at);
+            double before = r;
+            timeout_penalty(current_time, r);
+            if (r != before) pacer.dirty = true;
+            next_tick += 50;
+        }
     }
 
     game_over_screen(best_time);
+    report_latency(pacer);
 
     return 0;
 }
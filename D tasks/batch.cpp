@@ -0,0 +1,112 @@
+// batch.cpp — simulate a seed range of rounds on every core and summarise the outcomes
+// build: clang++ batch.cpp -std=c++17 -O2 -pthread -o batch
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "game_sim.hpp"
+#include "work_steal.hpp"
+
+// per-worker state: its own round, player pathfinding and tallies,
+// padded so two workers never write to the same cache line
+struct alignas(64) BatchWorker {
+    GameState    game;
+    AStarContext player_ctx;
+    long wins{0}, losses{0}, timeouts{0};
+    long coins{0}, steps{0}, ticks{0};
+};
+
+// usage: ./batch [--seeds FIRST LAST] [--size N] [--loop D] [--threads N] [--grain N]
+//                [--monsters N] [--coins N] [--policy random|exit]
+//                [--engine astar|dstar|flow|jps] [--max-seconds T]
+int main(int argc, char **argv)
+{
+    uint32_t seed_first = 1, seed_last = 10000;        // inclusive
+    int size = 25, monsters = 1, coins = 20;
+    float loop = 0.08f, max_seconds = 120.0f;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t grain = 16;
+    std::string policy = "exit", engine = "astar";
+    for (int i=1;i<argc;++i){
+        std::string k=argv[i];
+        auto val = [&]() -> std::string {
+            if (i+1>=argc) throw std::runtime_error("missing value for " + k);
+            return argv[++i];
+        };
+        try{
+            if      (k=="--seeds")       { seed_first=(uint32_t)std::stoul(val()); seed_last=(uint32_t)std::stoul(val()); }
+            else if (k=="--size")        size = std::stoi(val());
+            else if (k=="--loop")        loop = std::stof(val());
+            else if (k=="--threads")     threads = (unsigned)std::max(1, std::stoi(val()));
+            else if (k=="--grain")       grain = (size_t)std::max(1, std::stoi(val()));
+            else if (k=="--monsters")    monsters = std::stoi(val());
+            else if (k=="--coins")       coins = std::stoi(val());
+            else if (k=="--policy")      policy = val();
+            else if (k=="--engine")      engine = val();
+            else if (k=="--max-seconds") max_seconds = std::stof(val());
+            else { std::cerr<<"unknown option: "<<k<<"\n"; return 2; }
+        }catch(const std::exception& e){
+            std::cerr<<"bad option "<<k<<": "<<e.what()<<"\n";
+            return 2;
+        }
+    }
+    if (seed_last<seed_first){ std::cerr<<"empty seed range\n"; return 2; }
+
+    SimConfig cfg;   // same speeds as the windowed game at TILE = 32
+    cfg.engine = engine=="dstar" ? AI_DSTAR_LITE : engine=="flow" ? AI_FLOW_FIELD :
+                 engine=="jps" ? AI_JPS : AI_ASTAR_CACHED;
+    const long max_ticks = (long)(max_seconds / cfg.dt);
+    const bool random_policy = policy=="random";
+    const size_t rounds = (size_t)(seed_last - seed_first) + 1;
+
+    // every round depends only on its seed, so the totals do not depend on
+    // the thread count or on which worker ran which round
+    std::vector<BatchWorker> workers(threads);
+    std::vector<std::string> errors(threads);
+    auto w0 = std::chrono::steady_clock::now();
+    parallel_for_stealing(rounds, threads, grain, [&](unsigned w, size_t i){
+        BatchWorker &bw = workers[w];
+        if (!errors[w].empty()) return;
+        try{
+            MazeGenOptions gen;
+            gen.H = size; gen.W = size;
+            gen.seed = seed_first + (uint32_t)i;
+            gen.loop_density = loop;
+            sim_start_round(bw.game, cfg, make_round(gen, monsters, coins));
+
+            std::mt19937 rng(gen.seed);
+            RandomWalk walk;
+            GameState &g = bw.game;
+            while (!round_over(g) && g.ticks < max_ticks){
+                SimInput in = random_policy ? random_walk_input(walk, g, rng)
+                                            : seek_exit_input(bw.player_ctx, g);
+                sim_tick(g, cfg, in);
+            }
+            bw.wins += g.victory; bw.losses += g.game_over; bw.timeouts += !round_over(g);
+            bw.coins += g.coins_collected; bw.steps += g.player_steps; bw.ticks += g.ticks;
+        }catch(const std::exception& e){
+            errors[w] = e.what();
+        }
+    });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - w0).count();
+
+    for (auto &e : errors) if (!e.empty()){ std::cerr<<"ERROR: "<<e<<"\n"; return 1; }
+
+    BatchWorker sum;
+    for (auto &bw : workers){
+        sum.wins += bw.wins; sum.losses += bw.losses; sum.timeouts += bw.timeouts;
+        sum.coins += bw.coins; sum.steps += bw.steps; sum.ticks += bw.ticks;
+    }
+    const double n = (double)rounds;
+    std::cout<<"rounds "<<rounds<<" (seeds "<<seed_first<<".."<<seed_last<<") on "<<threads<<" threads\n";
+    std::cout<<"wins "<<sum.wins<<" ("<<100.0*sum.wins/n<<"%)  losses "<<sum.losses
+             <<"  timeouts "<<sum.timeouts<<"\n";
+    std::cout<<"avg coins "<<sum.coins/n<<"  avg steps "<<sum.steps/n<<"  avg ticks "<<sum.ticks/n<<"\n";
+    std::cout<<"wall "<<wall<<" s  ("<<(wall>0 ? n/wall : 0.0)<<" rounds/s)\n";
+    return 0;
+}
@@ -0,0 +1,50 @@
+// coin_grid.hpp — coins on maze cells with O(1) lookup by cell
+#ifndef COIN_GRID_HPP
+#define COIN_GRID_HPP
+
+#include <vector>
+#include <utility>
+
+#include "maze_grid.hpp"
+
+// coin
+struct Coin { int r{0}, c{0}; };
+
+// Live coins packed in `coins`; at[cell index] is the coin's slot there or -1.
+// Collecting swaps the last coin into the freed slot, so `coins` only ever
+// holds uncollected coins and pickup/draw never skip dead entries.
+struct CoinGrid {
+    std::vector<Coin> coins;
+    std::vector<int>  at;      // sized like MazeGrid::cells
+    int total{0};              // coins placed this round
+};
+
+inline void reset_coins(CoinGrid &cg, const MazeGrid &g, const std::vector<std::pair<int,int>> &cells)
+{
+    cg.at.assign(g.cells.size(), -1);
+    cg.coins.clear(); cg.coins.reserve(cells.size());
+    for (auto &cs : cells){
+        cg.at[g.index(cs.first, cs.second)] = (int)cg.coins.size();
+        cg.coins.push_back(Coin{cs.first, cs.second});
+    }
+    cg.total = (int)cg.coins.size();
+}
+
+// slot of the coin on cell (r,c), or -1
+inline int coin_at(const CoinGrid &cg, const MazeGrid &g, int r, int c)
+{
+    return cg.at[g.index(r, c)];
+}
+
+// remove the coin in `slot` (swap-and-pop)
+inline void collect_coin(CoinGrid &cg, const MazeGrid &g, int slot)
+{
+    const Coin gone = cg.coins[slot];
+    const Coin last = cg.coins.back();
+    cg.coins[slot] = last;
+    cg.at[g.index(last.r, last.c)] = slot;
+    cg.at[g.index(gone.r, gone.c)] = -1;
+    cg.coins.pop_back();
+}
+
+#endif // COIN_GRID_HPP
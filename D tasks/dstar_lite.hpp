@@ -0,0 +1,195 @@
+// dstar_lite.hpp — incremental pathfinding towards a moving goal
+#ifndef DSTAR_LITE_HPP
+#define DSTAR_LITE_HPP
+
+#include <cstdint>
+#include <cstdlib>   // for std::abs
+#include <vector>
+#include <utility>
+#include <algorithm> // for std::push_heap / std::pop_heap
+
+#include "maze_grid.hpp"
+
+// D* Lite (Koenig & Likhachev) searching backwards from the goal, so the
+// g-values are distances to the goal and the next step is simply the
+// neighbour with the smallest g. Search state survives between calls:
+//  - the start (monster) moving only bumps km, as in plain D* Lite;
+//  - the goal (player) moving changes rhs at the old and new goal cells
+//    only, and LPA* repairs the affected g-values from there.
+// Call dstar_reset whenever the maze is replaced.
+struct DStarLite {
+    struct Entry { int k1, k2, u; };
+
+    std::vector<int>     g, rhs;
+    std::vector<int>     qk1, qk2;   // key a cell is queued with
+    std::vector<uint8_t> inq;        // 1 while the cell is in the open list
+    std::vector<Entry>   open;       // lazy heap: stale entries are skipped
+    int start{-1}, goal{-1}, last{-1};
+    int km{0};
+    long long expanded{0};           // cells processed by the last query
+};
+
+static const int DSTAR_INF = 1<<29;
+
+inline void dstar_reset(DStarLite &d)
+{
+    d.start = d.goal = d.last = -1;
+}
+
+namespace dstar_detail {
+
+inline int h(const MazeGrid &g, int a, int b)
+{
+    return std::abs(g.row_of(a)-g.row_of(b)) + std::abs(g.col_of(a)-g.col_of(b));
+}
+
+inline bool later(const DStarLite::Entry &a, const DStarLite::Entry &b)
+{
+    return a.k1>b.k1 || (a.k1==b.k1 && a.k2>b.k2);
+}
+
+inline void calc_key(const MazeGrid &g, const DStarLite &d, int u, int &k1, int &k2)
+{
+    k2 = std::min(d.g[u], d.rhs[u]);
+    k1 = k2>=DSTAR_INF ? DSTAR_INF : k2 + h(g, d.start, u) + d.km;
+}
+
+inline void push(DStarLite &d, int u, int k1, int k2)
+{
+    d.inq[u]=1; d.qk1[u]=k1; d.qk2[u]=k2;
+    d.open.push_back({k1,k2,u});
+    std::push_heap(d.open.begin(), d.open.end(), later);
+}
+
+// drop stale heap entries; false when the open list is empty
+inline bool settle_top(DStarLite &d)
+{
+    while (!d.open.empty()){
+        const auto &e = d.open.front();
+        if (d.inq[e.u] && d.qk1[e.u]==e.k1 && d.qk2[e.u]==e.k2) return true;
+        std::pop_heap(d.open.begin(), d.open.end(), later);
+        d.open.pop_back();
+    }
+    return false;
+}
+
+inline void pop_top(DStarLite &d)
+{
+    std::pop_heap(d.open.begin(), d.open.end(), later);
+    d.open.pop_back();
+}
+
+inline int min_succ(const MazeGrid &g, const DStarLite &d, int u)
+{
+    int best=DSTAR_INF;
+    for (int k=0;k<4;++k){
+        int n=u+g.step[k];
+        if (g.cells[n]==WALL) continue;
+        if (d.g[n]+1<best) best=d.g[n]+1;
+    }
+    return best;
+}
+
+inline void update_vertex(const MazeGrid &g, DStarLite &d, int u)
+{
+    if (u!=d.goal) d.rhs[u]=min_succ(g, d, u);
+    d.inq[u]=0;
+    if (d.g[u]!=d.rhs[u]){
+        int k1,k2; calc_key(g, d, u, k1, k2);
+        push(d, u, k1, k2);
+    }
+}
+
+inline void compute_shortest_path(const MazeGrid &g, DStarLite &d)
+{
+    int sk1, sk2;
+    while (settle_top(d)){
+        calc_key(g, d, d.start, sk1, sk2);
+        const auto top = d.open.front();
+        bool top_first = top.k1<sk1 || (top.k1==sk1 && top.k2<sk2);
+        if (!top_first && d.rhs[d.start]==d.g[d.start]) break;
+
+        const int u=top.u;
+        pop_top(d); d.inq[u]=0;
+        ++d.expanded;
+        int k1,k2; calc_key(g, d, u, k1, k2);
+        if (top.k1<k1 || (top.k1==k1 && top.k2<k2)){
+            push(d, u, k1, k2);                // key grew since it was queued
+        } else if (d.g[u]>d.rhs[u]){        // overconsistent: settle it
+            d.g[u]=d.rhs[u];
+            for (int k=0;k<4;++k){
+                int n=u+g.step[k];
+                if (g.cells[n]!=WALL) update_vertex(g, d, n);
+            }
+        } else {                             // underconsistent: raise and re-expand
+            d.g[u]=DSTAR_INF;
+            update_vertex(g, d, u);
+            for (int k=0;k<4;++k){
+                int n=u+g.step[k];
+                if (g.cells[n]!=WALL) update_vertex(g, d, n);
+            }
+        }
+    }
+    // lazy entries pile up over many repairs; rebuild the heap from live ones
+    if (d.open.size() > 2*d.g.size() + 64){
+        d.open.clear();
+        for (int u=0;u<(int)d.inq.size();++u)
+            if (d.inq[u]) d.open.push_back({d.qk1[u],d.qk2[u],u});
+        std::make_heap(d.open.begin(), d.open.end(), later);
+    }
+}
+
+inline void init_search(const MazeGrid &g, DStarLite &d, int si, int ti)
+{
+    const size_t N=g.cells.size();
+    d.g.assign(N, DSTAR_INF);
+    d.rhs.assign(N, DSTAR_INF);
+    d.qk1.resize(N); d.qk2.resize(N);
+    d.inq.assign(N, 0);
+    d.open.clear();
+    d.start=d.last=si; d.goal=ti; d.km=0;
+    d.rhs[ti]=0;
+    push(d, ti, h(g, si, ti), 0);
+}
+
+} // namespace dstar_detail
+
+// next step from s towards t; keeps and repairs the search between calls.
+// Returns s when t is unreachable (the game's mazes are connected).
+inline std::pair<int,int> dstar_next_step(const MazeGrid &g, DStarLite &d,
+                                          std::pair<int,int> s, std::pair<int,int> t)
+{
+    using namespace dstar_detail;
+    if (s==t) return s;
+    const int si=g.index(s.first,s.second), ti=g.index(t.first,t.second);
+    d.expanded=0;
+
+    if (d.goal<0 || d.g.size()!=g.cells.size()){
+        init_search(g, d, si, ti);
+    } else {
+        // every start move shifts the heuristic, so km must follow it even
+        // when the goal stays put, or the queued keys stop being lower bounds
+        if (si!=d.last){ d.km += h(g, d.last, si); d.last=si; }
+        d.start=si;
+        if (ti!=d.goal){
+            int old=d.goal;
+            d.goal=ti;
+            d.rhs[ti]=0;
+            update_vertex(g, d, ti);
+            update_vertex(g, d, old);
+        }
+    }
+    compute_shortest_path(g, d);
+
+    if (d.g[si]>=DSTAR_INF) return s;
+    int best=-1, bestg=DSTAR_INF;
+    for (int k=0;k<4;++k){
+        int n=si+g.step[k];
+        if (g.cells[n]==WALL) continue;
+        if (d.g[n]<bestg){ bestg=d.g[n]; best=n; }
+    }
+    if (best<0) return s;
+    return {g.row_of(best), g.col_of(best)};
+}
+
+#endif // DSTAR_LITE_HPP
@@ -0,0 +1,54 @@
+// flow_field.hpp — one BFS distance field towards the player, shared by all monsters
+#ifndef FLOW_FIELD_HPP
+#define FLOW_FIELD_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm> // for std::fill
+
+#include "maze_grid.hpp"
+
+// dist[i] = steps from cell i to the goal, -1 if unreachable.
+// Rebuilt once per player cell; every monster then steps to the neighbour
+// one closer, so AI cost no longer scales with the number of monsters.
+struct FlowField {
+    std::vector<int> dist;
+    std::vector<int> frontier;   // BFS queue, storage kept between builds
+    int goal{-1};                // cell index the field points to
+};
+
+inline void build_flow_field(FlowField &f, const MazeGrid &g, std::pair<int,int> t)
+{
+    const size_t N = g.cells.size();
+    f.dist.resize(N);
+    std::fill(f.dist.begin(), f.dist.end(), -1);
+    f.frontier.resize(N);
+    f.goal = g.index(t.first, t.second);
+
+    size_t head=0, tail=0;
+    f.dist[f.goal]=0; f.frontier[tail++]=f.goal;
+    while (head<tail){
+        int u=f.frontier[head++], du=f.dist[u]+1;
+        for (int k=0;k<4;++k){
+            int n=u+g.step[k];
+            if (g.cells[n]==WALL || f.dist[n]>=0) continue;   // border cells are WALL
+            f.dist[n]=du;
+            f.frontier[tail++]=n;
+        }
+    }
+}
+
+// next step from s down the field; s itself when at the goal or cut off
+inline std::pair<int,int> flow_next_step(const FlowField &f, const MazeGrid &g, std::pair<int,int> s)
+{
+    if (f.goal<0 || f.dist.size()!=g.cells.size()) return s;
+    const int si=g.index(s.first,s.second), ds=f.dist[si];
+    if (ds<=0) return s;
+    for (int k=0;k<4;++k){
+        int n=si+g.step[k];
+        if (f.dist[n]==ds-1) return {g.row_of(n), g.col_of(n)};
+    }
+    return s;
+}
+
+#endif // FLOW_FIELD_HPP
@@ -0,0 +1,152 @@
+// frame_profiler.hpp — scoped per-phase frame timers, p50/p99 summaries and a Chrome trace dump
+#ifndef FRAME_PROFILER_HPP
+#define FRAME_PROFILER_HPP
+
+// Build with -DMAZE_PROFILE to compile the timers in. Without it PROF_SCOPE
+// expands to nothing and the functions below are empty inlines, so the game
+// and the headless tools pay nothing. Compiled in, profiler().enabled=false
+// leaves one predictable branch per scope.
+
+#include <cstdint>
+#include <string>
+
+enum ProfPhase {
+    PH_INPUT, PH_AI, PH_TWEEN, PH_COINS, PH_RULES,
+    PH_DRAW_MAP, PH_DRAW_SPRITES, PH_HUD, PH_PRESENT,
+    PH_COUNT
+};
+static const char *const PROF_PHASE_NAME[PH_COUNT] = {
+    "input", "ai", "tween", "coins", "rules",
+    "draw_map", "draw_sprites", "hud", "present"
+};
+
+#ifdef MAZE_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+struct FrameSample { uint32_t ns[PH_COUNT]; };            // time spent per phase in one frame
+struct TraceEvent  { uint64_t start_ns; uint32_t dur_ns; uint32_t phase; };
+
+// Two single-writer rings (the game thread writes; any thread may read after
+// an acquire load of the head). Old entries are simply overwritten.
+struct FrameProfiler {
+    static constexpr size_t FRAMES = 512;                 // powers of two
+    static constexpr size_t EVENTS = size_t(1) << 16;
+
+    bool enabled{true};
+    bool trace{false};                                    // also record every scope for dump_trace
+    uint64_t cur[PH_COUNT]{};                             // this frame so far
+    FrameSample frames[FRAMES]{};
+    std::atomic<uint64_t> frame_head{0};
+    TraceEvent events[EVENTS]{};
+    std::atomic<uint64_t> event_head{0};
+    std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+};
+
+inline FrameProfiler &profiler() { static FrameProfiler p; return p; }
+
+inline uint64_t prof_now_ns()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - profiler().origin).count();
+}
+
+struct ProfScope {
+    ProfPhase ph;
+    bool on;
+    uint64_t start{0};
+
+    explicit ProfScope(ProfPhase p) : ph(p), on(profiler().enabled) { if (on) start = prof_now_ns(); }
+    ~ProfScope()
+    {
+        if (!on) return;
+        FrameProfiler &P = profiler();
+        const uint64_t d = prof_now_ns() - start;
+        P.cur[ph] += d;
+        if (P.trace){
+            const uint64_t i = P.event_head.load(std::memory_order_relaxed);
+            P.events[i & (FrameProfiler::EVENTS-1)] = TraceEvent{start, (uint32_t)d, (uint32_t)ph};
+            P.event_head.store(i+1, std::memory_order_release);
+        }
+    }
+    ProfScope(const ProfScope&) = delete;
+    ProfScope& operator=(const ProfScope&) = delete;
+};
+
+#define PROF_CAT2(a, b) a##b
+#define PROF_CAT(a, b)  PROF_CAT2(a, b)
+#define PROF_SCOPE(ph)  ProfScope PROF_CAT(prof_scope_, __LINE__)(ph)
+
+// close the frame: publish this frame's phase totals and start the next
+inline void prof_end_frame()
+{
+    FrameProfiler &P = profiler();
+    if (!P.enabled) return;
+    const uint64_t i = P.frame_head.load(std::memory_order_relaxed);
+    FrameSample &s = P.frames[i & (FrameProfiler::FRAMES-1)];
+    for (int k=0;k<PH_COUNT;++k){
+        s.ns[k] = (uint32_t)std::min<uint64_t>(P.cur[k], UINT32_MAX);
+        P.cur[k] = 0;
+    }
+    P.frame_head.store(i+1, std::memory_order_release);
+}
+
+// p50 and p99 per phase over the frames still in the ring, in milliseconds
+inline void prof_percentiles(double p50[PH_COUNT], double p99[PH_COUNT])
+{
+    FrameProfiler &P = profiler();
+    const uint64_t head = P.frame_head.load(std::memory_order_acquire);
+    const size_t n = (size_t)std::min<uint64_t>(head, FrameProfiler::FRAMES);
+    std::vector<uint32_t> v(n);
+    for (int k=0;k<PH_COUNT;++k){
+        p50[k] = p99[k] = 0.0;
+        if (n==0) continue;
+        for (size_t j=0;j<n;++j) v[j] = P.frames[(head-1-j) & (FrameProfiler::FRAMES-1)].ns[k];
+        auto at = [&](double q){
+            size_t r = std::min(n-1, (size_t)(q*(n-1) + 0.5));
+            std::nth_element(v.begin(), v.begin()+r, v.end());
+            return v[r] / 1e6;
+        };
+        p50[k] = at(0.50);
+        p99[k] = at(0.99);
+    }
+}
+
+// write the recorded scopes as Chrome trace JSON (chrome://tracing, Perfetto)
+inline bool prof_dump_trace(const std::string &path)
+{
+    FrameProfiler &P = profiler();
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    const uint64_t head = P.event_head.load(std::memory_order_acquire);
+    const uint64_t first = head > FrameProfiler::EVENTS ? head - FrameProfiler::EVENTS : 0;
+    out << std::fixed << std::setprecision(3);   // µs down to the ns; 6 significant digits lose µs after 1 s
+    out << "{\"traceEvents\":[";
+    for (uint64_t i=first; i<head; ++i){
+        const TraceEvent &e = P.events[i & (FrameProfiler::EVENTS-1)];
+        out << (i==first ? "" : ",") << "\n{\"name\":\"" << PROF_PHASE_NAME[e.phase]
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << e.start_ns/1000.0
+            << ",\"dur\":" << e.dur_ns/1000.0 << "}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return (bool)out;
+}
+
+#else  // !MAZE_PROFILE
+
+#define PROF_SCOPE(ph) ((void)0)
+inline void prof_end_frame() {}
+inline void prof_percentiles(double p50[PH_COUNT], double p99[PH_COUNT])
+{
+    for (int k=0;k<PH_COUNT;++k) p50[k] = p99[k] = 0.0;
+}
+inline bool prof_dump_trace(const std::string &) { return false; }
+
+#endif // MAZE_PROFILE
+
+#endif // FRAME_PROFILER_HPP
@@ -0,0 +1,224 @@
+// game_sim.hpp — the game rules on a fixed timestep; no SplashKit, so it also runs headless
+#ifndef GAME_SIM_HPP
+#define GAME_SIM_HPP
+
+#include <vector>
+#include <random>
+#include <utility>
+
+#include "maze_grid.hpp"
+#include "pathfinding.hpp"
+#include "monster_ai.hpp"
+#include "round_setup.hpp"
+#include "coin_grid.hpp"
+#include "frame_profiler.hpp"
+
+// movement actor with tween; positions are in cells (x = column, y = row)
+struct Mover {
+    int r{0}, c{0};       // current cell
+    int tr{0}, tc{0};     // target cell
+    float t{0};           // 0..1
+    bool  moving{false};
+    float speed{5.0f};    // cells/s
+    float x{0}, y{0};     // position after the latest tick
+    float px{0}, py{0};   // position after the tick before (render interpolation)
+};
+
+inline void place_at_cell(Mover &m, int r, int c)
+{
+    m.r=r; m.c=c; m.tr=r; m.tc=c;
+    m.x=m.px=(float)c; m.y=m.py=(float)r;
+    m.t=0.0f; m.moving=false;
+}
+
+inline void start_move(Mover &m, int nr, int nc)
+{
+    m.tr=nr; m.tc=nc;
+    m.t=0.0f; m.moving=true;
+}
+
+// one tick; returns true on the tick that snaps the mover onto its target cell
+inline bool update_mover(Mover &m, float dt)
+{
+    m.px=m.x; m.py=m.y;
+    if (!m.moving) return false;
+    m.t += m.speed * dt;
+    if (m.t >= 1.0f) {
+        m.t = 1.0f; m.moving=false;
+        m.r = m.tr; m.c = m.tc;
+        m.x = (float)m.c; m.y = (float)m.r;
+        return true;
+    }
+    m.x = m.c + (m.tc - m.c) * m.t;
+    m.y = m.r + (m.tr - m.r) * m.t;
+    return false;
+}
+
+// position between the last two ticks, alpha in [0,1]
+inline float lerp_x(const Mover &m, float alpha) { return m.px + (m.x - m.px) * alpha; }
+inline float lerp_y(const Mover &m, float alpha) { return m.py + (m.y - m.py) * alpha; }
+
+// rules and speeds, all in cells and seconds
+struct SimConfig {
+    float    dt{1.0f/120.0f};        // fixed tick
+    float    player_speed{5.0f};     // cells/s
+    float    monster_speed{4.375f};
+    float    pick_radius{0.48f};     // cells
+    int      coin_value{100};
+    int      replan_drift{3};        // PathCache::max_drift
+    AiEngine engine{AI_ASTAR_CACHED};
+};
+
+// player intent for one tick (held direction); zero = stand still
+struct SimInput { int dr{0}, dc{0}; };
+
+// one round in progress
+struct GameState {
+    MazeGrid maze;
+    std::pair<int,int> exit_cell{-1,-1};
+    Mover player;
+    std::vector<Mover>     monsters;
+    std::vector<MonsterAI> ais;
+    FlowField player_field;          // shared by the monsters under AI_FLOW_FIELD
+    CoinGrid  coins;
+    int  coins_collected{0}, score{0};
+    long ticks{0};
+    long player_steps{0};            // cells the player has moved
+    bool victory{false}, game_over{false};
+};
+
+inline bool round_over(const GameState &s) { return s.victory || s.game_over; }
+
+inline void refresh_field(GameState &s, const SimConfig &cfg)
+{
+    if (cfg.engine==AI_FLOW_FIELD) build_flow_field(s.player_field, s.maze, {s.player.r, s.player.c});
+}
+
+// take over a laid-out round and reset everything else
+inline void sim_start_round(GameState &s, const SimConfig &cfg, RoundLayout &&L)
+{
+    s.maze = std::move(L.maze);
+    s.exit_cell = L.exit_cell;
+
+    place_at_cell(s.player, L.player.first, L.player.second);
+    s.player.speed = cfg.player_speed;
+    refresh_field(s, cfg);
+
+    s.monsters.resize(L.monsters.size());
+    s.ais.resize(L.monsters.size());
+    for (size_t i=0;i<s.monsters.size();++i){
+        place_at_cell(s.monsters[i], L.monsters[i].first, L.monsters[i].second);
+        s.monsters[i].speed = cfg.monster_speed;
+        MonsterAI &ai = s.ais[i];
+        ai.engine = cfg.engine;
+        ai.path.max_drift = cfg.replan_drift;
+        ai.field = &s.player_field;           // re-pointed every round, GameState may have moved
+        reset_ai(ai);
+    }
+
+    reset_coins(s.coins, s.maze, L.coins);
+    s.coins_collected = 0;
+    s.score = 0;
+    s.ticks = 0;
+    s.player_steps = 0;
+    s.victory = false; s.game_over = false;
+}
+
+// switch every monster to another engine mid-round
+inline void sim_set_engine(GameState &s, SimConfig &cfg, AiEngine e)
+{
+    cfg.engine = e;
+    for (auto &ai : s.ais){ ai.engine = e; reset_ai(ai); }
+    refresh_field(s, cfg);
+}
+
+// advance the round by exactly cfg.dt
+inline void sim_tick(GameState &s, const SimConfig &cfg, SimInput in)
+{
+    if (round_over(s)) return;
+    ++s.ticks;
+    Mover &player = s.player;
+
+    // input -> grid move
+    {
+        PROF_SCOPE(PH_INPUT);
+        if (!player.moving && (in.dr || in.dc)){
+            int nr=player.r+in.dr, nc=player.c+in.dc;
+            if (walkable(s.maze,nr,nc)) start_move(player, nr,nc);
+        }
+    }
+
+    // monster AI
+    {
+        PROF_SCOPE(PH_AI);
+        for (size_t i=0;i<s.monsters.size();++i){
+            Mover &monster = s.monsters[i];
+            if (monster.moving) continue;
+            auto step = monster_next_step(s.ais[i], s.maze, {monster.r,monster.c}, {player.r,player.c});
+            if (step != std::pair<int,int>{monster.r,monster.c}) start_move(monster, step.first, step.second);
+        }
+    }
+
+    // tween updates; the flow field follows the player cell by cell
+    {
+        PROF_SCOPE(PH_TWEEN);
+        if (update_mover(player, cfg.dt)){ ++s.player_steps; refresh_field(s, cfg); }
+        for (auto &monster : s.monsters) update_mover(monster, cfg.dt);
+    }
+
+    // coin pickup: the player sits on the segment between its cell and its
+    // target cell, every other cell centre is at least one cell away
+    // (> pick_radius), so only those two can hit
+    {
+        PROF_SCOPE(PH_COINS);
+        const float rad2 = cfg.pick_radius*cfg.pick_radius;
+        const std::pair<int,int> near[2] = {{player.r, player.c}, {player.tr, player.tc}};
+        for (int k=0; k<(near[1]==near[0] ? 1 : 2); ++k){
+            int slot = coin_at(s.coins, s.maze, near[k].first, near[k].second);
+            if (slot<0) continue;
+            float dx = player.x-near[k].second, dy = player.y-near[k].first;
+            if (dx*dx+dy*dy <= rad2){
+                collect_coin(s.coins, s.maze, slot);
+                ++s.coins_collected;
+                s.score += cfg.coin_value;
+            }
+        }
+    }
+
+    // win/lose checks
+    PROF_SCOPE(PH_RULES);
+    if (!player.moving && player.r==s.exit_cell.first && player.c==s.exit_cell.second) s.victory = true;
+    for (const auto &monster : s.monsters)
+        if (!player.moving && !monster.moving && player.r==monster.r && player.c==monster.c) s.game_over = true;
+}
+
+// ---------- scripted players (headless runs) ----------
+static const int SIM_DR[4] = {-1, +1, 0, 0};     // same order as MazeGrid::step
+static const int SIM_DC[4] = { 0, 0, -1, +1};
+
+// wander: keep going until blocked or at a junction, never turn back unless stuck
+struct RandomWalk { int last{-1}; };
+
+inline SimInput random_walk_input(RandomWalk &w, const GameState &s, std::mt19937 &rng)
+{
+    const Mover &p = s.player;
+    if (p.moving) return {};
+    int opts[4], n=0;
+    for (int k=0;k<4;++k)
+        if (walkable(s.maze, p.r+SIM_DR[k], p.c+SIM_DC[k]) && (w.last<0 || k!=(w.last^1))) opts[n++]=k;
+    int k = n ? opts[std::uniform_int_distribution<int>(0,n-1)(rng)] : (w.last^1);
+    if (k<0) return {};
+    w.last=k;
+    return {SIM_DR[k], SIM_DC[k]};
+}
+
+// head for the exit along A*, ignoring monsters and coins
+inline SimInput seek_exit_input(AStarContext &ctx, const GameState &s)
+{
+    const Mover &p = s.player;
+    if (p.moving) return {};
+    auto step = astar_next_step(s.maze, ctx, {p.r,p.c}, s.exit_cell);
+    return {step.first-p.r, step.second-p.c};
+}
+
+#endif // GAME_SIM_HPP
@@ -1,6 +1,7 @@
 import json
 import random
 import argparse
+import struct
 import sys
 from heapq import heappush, heappop
 from typing import List, Tuple, Optional
@@ -306,6 +307,25 @@ def astar_next_step(g: List[List[int]], start: Tuple[int, int], goal: Tuple[int,
     return path[-1]
 
 
+def _write_binary_maze(path: str, g: List[List[int]], exit_rc: Tuple[int, int], seed: Optional[int] = None) -> None:
+    """
+    Write the compact .mzb format read by maze_io.hpp:
+    a 32-byte little-endian header (magic "MZB1", version, H, W, exit r/c, seed, words per row)
+    followed by H rows of 64-bit words, bit c set for WALL.
+    """
+    H, W = len(g), len(g[0])
+    words = (W + 63) // 64
+    with open(path, "wb") as f:
+        f.write(struct.pack("<4sIiiiiII", b"MZB1", 1, H, W, exit_rc[0], exit_rc[1],
+                            (seed or 0) & 0xFFFFFFFF, words))
+        for row in g:
+            bits = 0
+            for c, v in enumerate(row):
+                if v == WALL:
+                    bits |= 1 << c
+            f.write(bits.to_bytes(words * 8, "little"))
+
+
 def _read_json_maze(path: str) -> List[List[int]]:
     """
     Read a maze JSON file. The expected format for this CLI is a direct 2D array of 0/1.
@@ -350,7 +370,8 @@ def main():
         default=0.08,
         help="loop density [0.0~0.5]; more loops reduce linearity"
     )
-    pgen.add_argument("--out", type=str, default="maze.json", help="output file path")
+    pgen.add_argument("--out", type=str, default="maze.json",
+                      help="output file path (.mzb writes the compact binary format)")
 
     # Subcommand: compute the next step using A* on an existing maze
     pns = sub.add_parser("next-step", help="compute next step by A*")
@@ -380,8 +401,11 @@ def main():
         g, exit_rc = generate_single_exit_maze(
             H=args.H, W=args.W, seed=args.seed, exit_side=args.exit, loop_density=args.loop
         )
-        with open(args.out, "w", encoding="utf-8") as f:
-            json.dump(g, f, ensure_ascii=False)
+        if args.out.endswith(".mzb"):
+            _write_binary_maze(args.out, g, exit_rc, args.seed)
+        else:
+            with open(args.out, "w", encoding="utf-8") as f:
+                json.dump(g, f, ensure_ascii=False)
         print(json.dumps(
             {"ok": True, "file": args.out, "exit": {"r": exit_rc[0], "c": exit_rc[1]}},
             ensure_ascii=False
@@ -0,0 +1,128 @@
+// headless.cpp — run maze rounds with no window, as fast as the simulation allows
+// build: clang++ headless.cpp -std=c++17 -O2 -pthread -o headless
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "game_sim.hpp"
+#include "replay_log.hpp"
+
+// replay every round of a log and compare with how it ended when recorded
+static int replay_main(const std::string &path)
+{
+    ReplayLog log = read_replay(path);
+    SimConfig cfg = log.cfg;
+    GameState game;
+    long ticks=0, desync=0, unfinished=0;
+
+    auto w0 = std::chrono::steady_clock::now();
+    for (size_t i=0;i<log.rounds.size();++i){
+        const ReplayRound &R = log.rounds[i];
+        ReplayResult got = replay_round(game, cfg, R);
+        ticks += got.ticks;
+        if (!R.ended){ ++unfinished; continue; }
+        if (!(got == R.expected)){
+            ++desync;
+            std::cerr<<"round "<<i<<" desync: recorded outcome "<<(int)R.expected.outcome
+                     <<" ticks "<<R.expected.ticks<<" score "<<R.expected.score
+                     <<", replayed outcome "<<(int)got.outcome<<" ticks "<<got.ticks<<" score "<<got.score<<"\n";
+        }
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - w0).count();
+    double simulated = ticks * (double)cfg.dt;
+
+    std::cout<<"replayed "<<log.rounds.size()<<" rounds  desync "<<desync<<"  unfinished "<<unfinished<<"\n";
+    std::cout<<"simulated "<<simulated<<" s in "<<wall<<" s wall ("
+             <<(wall>0 ? simulated/wall : 0.0)<<"x real time)\n";
+    std::cout<<"log "<<log.bytes<<" bytes ("<<(simulated>0 ? log.bytes/simulated : 0.0)<<" bytes per second of play)\n";
+    return desync ? 3 : 0;
+}
+
+// usage: ./headless [--rounds N] [--size N] [--loop D] [--seed S]
+//                   [--monsters N] [--coins N] [--policy random|exit]
+//                   [--engine astar|dstar|flow|jps] [--max-seconds T]
+//                   [--record log.mzr]
+//        ./headless --replay log.mzr
+// --record logs every round it plays; --replay runs a log from the game or
+// from --record as fast as possible and checks every round ends as recorded.
+int main(int argc, char **argv)
+{
+    int rounds = 1000, size = 25, monsters = 1, coins = 20;
+    float loop = 0.08f, max_seconds = 120.0f;
+    uint32_t seed = 1;
+    std::string policy = "exit", engine = "astar", record, replay;
+    for (int i=1;i+1<argc;i+=2){
+        std::string k=argv[i], v=argv[i+1];
+        if      (k=="--rounds")      rounds = std::atoi(v.c_str());
+        else if (k=="--size")        size = std::atoi(v.c_str());
+        else if (k=="--loop")        loop = (float)std::atof(v.c_str());
+        else if (k=="--seed")        seed = (uint32_t)std::strtoul(v.c_str(), nullptr, 10);
+        else if (k=="--monsters")    monsters = std::atoi(v.c_str());
+        else if (k=="--coins")       coins = std::atoi(v.c_str());
+        else if (k=="--policy")      policy = v;
+        else if (k=="--engine")      engine = v;
+        else if (k=="--max-seconds") max_seconds = (float)std::atof(v.c_str());
+        else if (k=="--record")      record = v;
+        else if (k=="--replay")      replay = v;
+        else { std::cerr<<"unknown option: "<<k<<"\n"; return 2; }
+    }
+
+    try{
+        if (!replay.empty()) return replay_main(replay);
+
+        SimConfig cfg;   // same speeds as the windowed game at TILE = 32
+        cfg.engine = engine=="dstar" ? AI_DSTAR_LITE : engine=="flow" ? AI_FLOW_FIELD :
+                     engine=="jps" ? AI_JPS : AI_ASTAR_CACHED;
+        const long max_ticks = (long)(max_seconds / cfg.dt);
+
+        GameState game;
+        AStarContext player_ctx;
+        ReplayWriter rec;
+        if (!record.empty()) open_replay(rec, record, cfg);
+        long wins=0, losses=0, timeouts=0, total_coins=0, total_ticks=0;
+
+        auto w0 = std::chrono::steady_clock::now();
+        for (int i=0;i<rounds;++i){
+            MazeGenOptions gen;
+            gen.H = size; gen.W = size;
+            gen.seed = seed + (uint32_t)i;
+            gen.loop_density = loop;
+            RoundLayout L = make_round(gen, monsters, coins);
+            replay_begin_round(rec, L, cfg.engine);
+            sim_start_round(game, cfg, std::move(L));
+
+            std::mt19937 rng(gen.seed);
+            RandomWalk walk;
+            while (!round_over(game) && game.ticks < max_ticks){
+                SimInput in = policy=="random" ? random_walk_input(walk, game, rng)
+                                               : seek_exit_input(player_ctx, game);
+                replay_tick(rec, game, in);
+                sim_tick(game, cfg, in);
+            }
+            replay_end_round(rec, game);
+            wins += game.victory; losses += game.game_over; timeouts += !round_over(game);
+            total_coins += game.coins_collected; total_ticks += game.ticks;
+        }
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - w0).count();
+        double simulated = total_ticks * (double)cfg.dt;
+
+        std::cout<<"rounds "<<rounds<<"  wins "<<wins<<"  losses "<<losses<<"  timeouts "<<timeouts<<"\n";
+        std::cout<<"avg coins "<<(rounds ? (double)total_coins/rounds : 0.0)
+                 <<"  avg ticks "<<(rounds ? (double)total_ticks/rounds : 0.0)<<"\n";
+        std::cout<<"simulated "<<simulated<<" s in "<<wall<<" s wall ("
+                 <<(wall>0 ? simulated/wall : 0.0)<<"x real time, "
+                 <<(wall>0 ? rounds/wall : 0.0)<<" rounds/s)\n";
+        if (!record.empty()){
+            close_replay(rec, game);
+            std::cout<<"recorded "<<rec.bytes<<" bytes -> "<<record<<" ("
+                     <<(simulated>0 ? rec.bytes/simulated : 0.0)<<" bytes per simulated second)\n";
+        }
+    }catch(const std::exception& e){
+        std::cerr<<"ERROR: "<<e.what()<<"\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+// jps.hpp — Jump Point Search (4-connected) over a MazeGrid, with 64-cell bitset row scans
+#ifndef JPS_HPP
+#define JPS_HPP
+
+#include <cstdint>
+#include <cstdlib>   // for std::abs
+#include <vector>
+#include <utility>
+#include <algorithm>
+#ifdef _MSC_VER
+  #include <intrin.h>   // _BitScanForward64 / _BitScanReverse64
+#endif
+
+#include "maze_grid.hpp"
+#include "pathfinding.hpp"
+
+// Wall bits of every bordered row (1 = WALL), with JPS_PAD wall bits on each
+// side so a 64-bit window can be read at any column without bounds tests.
+// Bit JPS_PAD+bc of row br is cell index br*stride+bc.
+static const int JPS_PAD = 64;
+
+struct JpsContext {
+    AStarContext astar;              // open list, g scores, parents, epoch stamps
+    std::vector<uint64_t> bits;      // (H+2) rows of `words` words
+    int  words{0};
+    bool built{false};               // cleared by jps_reset when the maze changes
+};
+
+inline void jps_reset(JpsContext &j) { j.built = false; }
+
+namespace jps_detail {
+
+inline void build_bits(JpsContext &j, const MazeGrid &g)
+{
+    j.words = (g.stride + 2*JPS_PAD + 63) / 64;
+    j.bits.assign((size_t)(g.H+2) * j.words, ~uint64_t(0));
+    for (int br=0; br<g.H+2; ++br){
+        uint64_t *row = &j.bits[(size_t)br*j.words];
+        const uint8_t *cell = &g.cells[(size_t)br*g.stride];
+        for (int bc=0; bc<g.stride; ++bc)
+            if (cell[bc]!=WALL) row[(bc+JPS_PAD)>>6] &= ~(uint64_t(1) << ((bc+JPS_PAD)&63));
+    }
+    j.built = true;
+}
+
+// lowest / highest set bit of a non-zero word; MSVC has no __builtin_ctzll
+inline int low_bit(uint64_t v)
+{
+#ifdef _MSC_VER
+    unsigned long k; _BitScanForward64(&k, v); return (int)k;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+inline int high_bit(uint64_t v)
+{
+#ifdef _MSC_VER
+    unsigned long k; _BitScanReverse64(&k, v); return (int)k;
+#else
+    return 63-__builtin_clzll(v);
+#endif
+}
+
+// 64 wall bits starting at padded bit position p
+inline uint64_t window(const uint64_t *row, int p)
+{
+    const int w=p>>6, s=p&63;
+    return s ? (row[w] >> s) | (row[w+1] << (64-s)) : row[w];
+}
+
+// Horizontal jump from cell (br,bc) in direction dx, 64 columns per step.
+// Stops at the goal, at a wall (no jump point) or at a forced neighbour:
+// an open cell above/below whose counterpart one column back is a wall.
+// Returns the jump point's bordered column, or -1.
+inline int jump_h(const JpsContext &j, int br, int bc, int dx, int goal_br, int goal_bc)
+{
+    const uint64_t *R=&j.bits[(size_t)br*j.words], *U=R-j.words, *D=R+j.words;
+    const bool goal_row = br==goal_br;
+    int x = bc+dx;
+    if (dx>0){
+        for (;;){
+            const int p = x+JPS_PAD;
+            const uint64_t B=window(R,p);
+            uint64_t stop = B | (~window(U,p) & window(U,p-1)) | (~window(D,p) & window(D,p-1));
+            if (goal_row && goal_bc>=x && goal_bc<x+64) stop |= uint64_t(1) << (goal_bc-x);
+            if (stop){
+                const int k=low_bit(stop);
+                return (B>>k & 1) ? -1 : x+k;
+            }
+            x += 64;
+        }
+    } else {
+        for (;;){
+            const int lo = x-63, p = lo+JPS_PAD;     // window covers columns lo..x
+            const uint64_t B=window(R,p);
+            uint64_t stop = B | (~window(U,p) & window(U,p+1)) | (~window(D,p) & window(D,p+1));
+            if (goal_row && goal_bc<=x && goal_bc>=lo) stop |= uint64_t(1) << (goal_bc-lo);
+            if (stop){
+                const int k=high_bit(stop);
+                return (B>>k & 1) ? -1 : lo+k;
+            }
+            x -= 64;
+        }
+    }
+}
+
+// Vertical jump from cell index i in direction dy (+1 down, -1 up), cell by
+// cell. A cell is a jump point when it is the goal, has a forced left/right
+// neighbour, or a horizontal jump from it finds one.
+inline int jump_v(const JpsContext &j, const MazeGrid &g, int i, int dy, int goal)
+{
+    const int st = dy*g.stride;
+    const int goal_br = goal/g.stride, goal_bc = goal%g.stride;
+    const uint8_t *cell = g.cells.data();
+    for (i+=st; cell[i]!=WALL; i+=st){
+        if (i==goal) return i;
+        if ((cell[i-1]!=WALL && cell[i-1-st]==WALL) || (cell[i+1]!=WALL && cell[i+1-st]==WALL)) return i;
+        const int br=i/g.stride, bc=i%g.stride;
+        if (jump_h(j, br, bc, +1, goal_br, goal_bc)>=0 || jump_h(j, br, bc, -1, goal_br, goal_bc)>=0) return i;
+    }
+    return -1;
+}
+
+} // namespace jps_detail
+
+// JPS from cell index si towards ti; same contract as astar_search: returns
+// ti when reachable, else the jump point with the best f (si if none).
+// ctx.astar.came links jump points, not single cells.
+inline int jps_search(const MazeGrid &g, JpsContext &j, int si, int ti)
+{
+    using namespace jps_detail;
+    if (!j.built || j.bits.size() != (size_t)(g.H+2)*((g.stride + 2*JPS_PAD + 63) / 64)) build_bits(j, g);
+    AStarContext &ctx = j.astar;
+    begin_search(ctx, g);
+    const int S=g.stride, tr=ti/S, tc=ti%S;
+    auto h = [&](int i){ return std::abs(i/S-tr)+std::abs(i%S-tc); };
+    auto worse = [](const AStarContext::Node&a, const AStarContext::Node&b){
+        return (a.f>b.f) || (a.f==b.f && a.g>b.g);
+    };
+    auto relax = [&](int from, int gfrom, int to, int &bestf, int &best){
+        const int ng = gfrom + std::abs(to/S-from/S) + std::abs(to%S-from%S);
+        if (ctx.stamp[to]==ctx.epoch && ng>=ctx.gscore[to]) return;
+        ctx.stamp[to]=ctx.epoch; ctx.gscore[to]=ng; ctx.came[to]=from;
+        const int nf=ng+h(to);
+        if (nf<bestf || (nf==bestf && to<best)){ bestf=nf; best=to; }
+        ctx.open.push_back({to,ng,nf});
+        std::push_heap(ctx.open.begin(), ctx.open.end(), worse);
+    };
+
+    ctx.stamp[si]=ctx.epoch; ctx.gscore[si]=0; ctx.came[si]=-1;
+    ctx.open.push_back({si,0,h(si)});
+    int bestf=ctx.open[0].f, best=si;
+
+    while (!ctx.open.empty()){
+        std::pop_heap(ctx.open.begin(), ctx.open.end(), worse);
+        auto cur = ctx.open.back(); ctx.open.pop_back();
+        if (cur.g > ctx.gscore[cur.i]) continue;   // stale entry
+        ++ctx.expanded;
+        if (cur.i==ti) return ti;
+
+        // pruned directions: all four from the start; after a horizontal
+        // move forward + up + down, after a vertical one forward + left + right
+        const int i=cur.i, br=i/S, bc=i%S, p=ctx.came[i];
+        const int fdx = p<0 ? 0 : (bc>p%S) - (bc<p%S);   // arrival direction
+        const int fdy = p<0 ? 0 : (br>p/S) - (br<p/S);
+        for (int dx : {+1, -1}){
+            if (fdx!=0 && dx!=fdx) continue;               // never straight back
+            if (g.cells[i+dx]==WALL) continue;
+            const int jc = jump_h(j, br, bc, dx, tr, tc);
+            if (jc>=0) relax(i, cur.g, br*S+jc, bestf, best);
+        }
+        for (int dy : {+1, -1}){
+            if (fdy!=0 && dy!=fdy) continue;
+            if (g.cells[i+dy*S]==WALL) continue;
+            const int jv = jump_v(j, g, i, dy, ti);
+            if (jv>=0) relax(i, cur.g, jv, bestf, best);
+        }
+    }
+    return best;
+}
+
+// JPS path: cell indices from the step after s up to the target chosen by
+// jps_search, with the straight runs between jump points filled in
+inline void jps_path(const MazeGrid &g, JpsContext &j,
+                     std::pair<int,int> s, std::pair<int,int> t, std::vector<int> &path)
+{
+    path.clear();
+    if (s==t) return;
+    const int si=g.index(s.first,s.second);
+    int cur=jps_search(g, j, si, g.index(t.first,t.second));
+    while (cur!=si && cur!=-1){
+        const int prev=j.astar.came[cur];
+        if (prev<0) break;
+        const int d = (cur/g.stride!=prev/g.stride) ? (cur>prev ? g.stride : -g.stride) : (cur>prev ? 1 : -1);
+        for (int c=cur; c!=prev; c-=d) path.push_back(c);
+        cur=prev;
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+// first step of the JPS path: one cell from s towards the first jump point
+inline std::pair<int,int> jps_next_step(const MazeGrid &g, JpsContext &j,
+                                        std::pair<int,int> s, std::pair<int,int> t)
+{
+    if (s==t) return s;
+    const int si=g.index(s.first,s.second);
+    int cur=jps_search(g, j, si, g.index(t.first,t.second)), next=-1;
+    while (cur!=si && cur!=-1){ next=cur; cur=j.astar.came[cur]; }
+    if (next==-1) return s;
+    const int S=g.stride;
+    const int d = (next/S!=si/S) ? (next>si ? S : -S) : (next>si ? 1 : -1);
+    const int n = si+d;
+    return {g.row_of(n), g.col_of(n)};
+}
+
+#endif // JPS_HPP
@@ -8,30 +8,43 @@
 #include <sstream>
 #include <chrono>
 #include <algorithm>
-#include <set>
-#include <queue>     // for std::priority_queue
-#include <cstdlib>   // for std::system
-#include <cmath>     // for std::abs
+#include <cmath>
 
 #include "splashkit.h"
-#include "nlohmann/json.hpp"
+#include "maze_grid.hpp"
+#include "maze_io.hpp"
+#include "monster_ai.hpp"
+#include "maze_gen.hpp"
+#include "round_setup.hpp"
+#include "coin_grid.hpp"
+#include "game_sim.hpp"
+#include "replay_log.hpp"
+#include "frame_profiler.hpp"
 
 using std::string;
 using std::vector;
 using std::pair;
 
-static const int WALL = 1;
-static const int ROAD = 0;
-
 // ---------- Tunables ----------
 static int   TILE         = 32;
 static int   PADDING      = 0;
 static float PLAYER_SPEED = 160.0f;   // px/s
 static float MONSTER_SPEED= 140.0f;   // px/s
-static int   NUM_COINS    = 20;        // coins per round
+static int   NUM_COINS    = 20;        // coins per round (capped by free ROAD cells)
 static int   COIN_VALUE   = 100;      // score per coin
 static float PICK_RADIUS  = 0.48f;    // in tiles
 static int   FPS_LIMIT    = 60;       // refresh FPS
+static int   SIM_HZ       = 120;      // fixed simulation ticks per second
+static float MAX_FRAME_DT = 0.25f;    // longest frame fed to the simulation (s)
+static int   AI_REPLAN_DRIFT = 3;     // cells the player may stray before the monster replans
+static AiEngine AI_ENGINE = AI_ASTAR_CACHED; // monster pathfinding engine (TAB cycles)
+static int   NUM_MONSTERS = 1;        // monsters per round
+static float LOOP_DENSITY = 0.08f;    // generated mazes: share of loop walls removed
+static int   VIEW_TILES_W = 25;       // viewport size in tiles (window never grows past it)
+static int   VIEW_TILES_H = 25;
+static int   CHUNK_TILES  = 16;       // static-layer cache chunk side, in tiles
+static int   CULL_MARGIN  = 1;        // extra tiles drawn around the viewport
+static const char *PROFILE_TRACE = "trace.json"; // -DMAZE_PROFILE builds: Chrome trace written on exit ("" = off)
 // -----------------------------
 
 // px <-> cell helpers
@@ -49,459 +62,445 @@ inline drawing_options make_tile_scale(bitmap bmp)
     return option_scale_bmp(sx, sy);
 }
 
-// read maze: top-level 2D int array
-vector<vector<int>> load_maze(const string &path)
+// 判断文件是否存在（跨平台简易法）
+static bool file_exists(const std::string& path)
 {
-    std::ifstream in(path);
-    if (!in.is_open()) throw std::runtime_error("cannot open: " + path);
-
-    nlohmann::json nj; in >> nj;
-    if (!nj.is_array() || nj.empty() || !nj[0].is_array())
-        throw std::runtime_error("maze.json must be a 2D array");
-
-    vector<vector<int>> g; g.reserve(nj.size());
-    for (auto &row : nj)
-    {
-        vector<int> r; r.reserve(row.size());
-        for (auto &x : row) r.push_back((int)x);
-        g.push_back(std::move(r));
-    }
-    return g;
+    std::ifstream f(path);
+    return (bool)f;
 }
 
-// find the unique border exit (r,c)
-pair<int,int> find_single_exit(const vector<vector<int>>& g)
+// interpolated top-left px of a mover, alpha in [0,1] between the last two ticks
+inline float mover_px_x(const Mover &m, float alpha) { return lerp_x(m, alpha) * TILE + PADDING; }
+inline float mover_px_y(const Mover &m, float alpha) { return lerp_y(m, alpha) * TILE + PADDING; }
+
+// ---------- camera + viewport culling ----------
+// top-left corner of the viewport in world px
+struct Camera { float x{0}, y{0}; int view_w{0}, view_h{0}; };
+
+// visible tiles, widened by CULL_MARGIN and clamped to the maze: rows [r0,r1), cols [c0,c1)
+struct TileRange { int r0{0}, c0{0}, r1{0}, c1{0}; };
+
+// centre the viewport on (fx,fy) without showing anything outside the world
+void center_camera(Camera &cam, float fx, float fy, int world_w, int world_h)
 {
-    int H=(int)g.size(), W=(int)g[0].size();
-    vector<pair<int,int>> exits;
-    for (int c=0;c<W;++c){
-        if (g[0][c]==ROAD)   exits.emplace_back(0,c);
-        if (g[H-1][c]==ROAD) exits.emplace_back(H-1,c);
-    }
-    for (int r=0;r<H;++r){
-        if (g[r][0]==ROAD)   exits.emplace_back(r,0);
-        if (g[r][W-1]==ROAD) exits.emplace_back(r,W-1);
-    }
-    if (exits.size()!=1) throw std::runtime_error("maze border must contain exactly one exit");
-    return exits[0];
+    cam.x = std::floor(std::max(0.0f, std::min(fx - cam.view_w*0.5f, (float)(world_w - cam.view_w))));
+    cam.y = std::floor(std::max(0.0f, std::min(fy - cam.view_h*0.5f, (float)(world_h - cam.view_h))));
+    set_camera_position(point_at(cam.x, cam.y));
 }
 
-// pick a random ROAD cell
-pair<int,int> random_road(const vector<vector<int>> &g, std::mt19937 &rng)
+TileRange visible_tiles(const Camera &cam, const MazeGrid &g)
 {
-    int H=(int)g.size(), W=(int)g[0].size();
-    vector<pair<int,int>> roads; roads.reserve(H*W/2);
-    for (int r=0;r<H;++r) for (int c=0;c<W;++c)
-        if (g[r][c]==ROAD) roads.emplace_back(r,c);
-    if (roads.empty()) throw std::runtime_error("no ROAD cells");
-    std::uniform_int_distribution<> dist(0,(int)roads.size()-1);
-    return roads[dist(rng)];
+    TileRange v;
+    v.r0 = std::max(0,   (int)std::floor((cam.y - PADDING) / TILE) - CULL_MARGIN);
+    v.c0 = std::max(0,   (int)std::floor((cam.x - PADDING) / TILE) - CULL_MARGIN);
+    v.r1 = std::min(g.H, (int)std::ceil((cam.y + cam.view_h - PADDING) / TILE) + CULL_MARGIN);
+    v.c1 = std::min(g.W, (int)std::ceil((cam.x + cam.view_w - PADDING) / TILE) + CULL_MARGIN);
+    return v;
 }
 
-// 判断文件是否存在（跨平台简易法）
-static bool file_exists(const std::string& path)
+// ---------- sprite atlas ----------
+// enum order is draw order: batched sprites are sorted by it
+enum Sprite { SPR_FLOOR, SPR_WALL, SPR_GOLD, SPR_PLAYER, SPR_MONSTER, SPR_COUNT };
+
+// Every sprite scaled to TILE once at startup and packed side by side in one
+// bitmap, ATLAS_GUTTER transparent px apart so a cell never picks up its
+// neighbour's edge. A draw only picks its cell with option_part_bmp, so there
+// is one texture for the whole scene and no per-draw rescale.
+static const int ATLAS_GUTTER = 2;
+
+struct SpriteAtlas {
+    bitmap sheet{nullptr};
+    drawing_options part[SPR_COUNT];
+};
+
+// a missing file is painted as the old coloured fallback shape instead
+void build_atlas(SpriteAtlas &a)
 {
-    std::ifstream f(path);
-    return (bool)f;
+    static const char *NAME[SPR_COUNT] = {"floor", "wall", "gold", "player", "monster"};
+    static const char *PATH[SPR_COUNT] = {"Floor.bmp", "Wall.bmp", "Gold.png", "Player.bmp", "Monster.png"};
+
+    a.sheet = create_bitmap("sprite_atlas", SPR_COUNT*(TILE+ATLAS_GUTTER), TILE);
+    clear_bitmap(a.sheet, COLOR_TRANSPARENT);
+    for (int k=0;k<SPR_COUNT;++k){
+        const float x = (float)(k*(TILE+ATLAS_GUTTER));
+        a.part[k] = option_part_bmp(x, 0, TILE, TILE);
+        bitmap src = load_bitmap(NAME[k], PATH[k]);
+        if (bitmap_valid(src)){
+            // option_scale_bmp scales about the bitmap's centre: shift back so the TILE² result starts at (x,0)
+            const float w = (float)bitmap_width(src), h = (float)bitmap_height(src);
+            draw_bitmap_on_bitmap(a.sheet, src, x - (w-TILE)*0.5f, -(h-TILE)*0.5f, make_tile_scale(src));
+            free_bitmap(src);
+            continue;
+        }
+        if      (k==SPR_FLOOR)   fill_rectangle_on_bitmap(a.sheet, COLOR_GRAY, x, 0, TILE, TILE);
+        else if (k==SPR_WALL)    fill_rectangle_on_bitmap(a.sheet, COLOR_DARK_GREEN, x, 0, TILE, TILE);
+        else if (k==SPR_GOLD)    fill_circle_on_bitmap(a.sheet, COLOR_YELLOW, x+TILE*0.5f, TILE*0.5f, TILE*0.30f);
+        else if (k==SPR_PLAYER)  fill_rectangle_on_bitmap(a.sheet, COLOR_BLUE, x, 0, TILE, TILE);
+        else                     fill_rectangle_on_bitmap(a.sheet, COLOR_RED, x, 0, TILE, TILE);
+    }
 }
 
-// 调用 Python 生成 maze.json（失败返回 false）
-// 会尝试 `python`，失败再试 `python3`
-static bool generate_maze_via_python(const std::string& out_path, int H, int W, int seed = -1)
+void free_atlas(SpriteAtlas &a)
 {
-    std::ostringstream cmd;
-    cmd << "python generator.py generate --H " << H
-        << " --W " << W
-        << " --out " << out_path;
-    if (seed >= 0) cmd << " --seed " << seed;
-
-    int ret = std::system(cmd.str().c_str());
-    if (ret != 0) {
-        std::ostringstream cmd2;
-        cmd2 << "python3 generator.py generate --H " << H
-             << " --W " << W
-             << " --out " << out_path;
-        if (seed >= 0) cmd2 << " --seed " << seed;
-        ret = std::system(cmd2.str().c_str());
-    }
-    return file_exists(out_path);
+    if (bitmap_valid(a.sheet)) free_bitmap(a.sheet);
+    a.sheet = nullptr;
 }
 
+// ---------- sprite batch ----------
+struct SpriteDraw { uint8_t sprite; float x, y; };
 
-// movement actor with tween
-struct Mover {
-    int r{0}, c{0};       // current cell
-    int tr{0}, tc{0};     // target cell
-    float x{0}, y{0};     // current px
-    float sx{0}, sy{0};   // start px
-    float tx{0}, ty{0};   // target px
-    float t{0};           // 0..1
-    bool  moving{false};
-    float speed{160.0f};  // px/s
+// Dynamic sprites for one frame. flush_batch culls them to the viewport,
+// orders them by layer and drops exact repeats (stacked monsters, say), then
+// draws the rest straight from the atlas.
+struct SpriteBatch {
+    vector<SpriteDraw> items;
+    size_t submitted{0}, drawn{0};   // last flush, for the HUD/profiler
 };
 
-void place_at_cell(Mover &m, int r, int c)
+inline void batch_sprite(SpriteBatch &b, Sprite s, float x, float y)
 {
-    m.r=r; m.c=c; m.tr=r; m.tc=c;
-    m.x=cell_to_px_c(c); m.y=cell_to_px_r(r);
-    m.sx=m.tx=m.x; m.sy=m.ty=m.y;
-    m.t=0.0f; m.moving=false;
+    b.items.push_back({(uint8_t)s, x, y});
 }
 
-void start_move(Mover &m, int nr, int nc)
+void flush_batch(SpriteBatch &b, const SpriteAtlas &a, const Camera &cam)
 {
-    m.tr=nr; m.tc=nc;
-    m.sx=m.x; m.sy=m.y;
-    m.tx=cell_to_px_c(nc); m.ty=cell_to_px_r(nr);
-    m.t=0.0f; m.moving=true;
+    b.submitted = b.items.size();
+    size_t n = 0;
+    for (const SpriteDraw &d : b.items)                      // cull, in place
+        if (d.x + TILE >= cam.x && d.x <= cam.x + cam.view_w &&
+            d.y + TILE >= cam.y && d.y <= cam.y + cam.view_h) b.items[n++] = d;
+    b.items.resize(n);
+    std::sort(b.items.begin(), b.items.end(), [](const SpriteDraw &p, const SpriteDraw &q){
+        if (p.sprite != q.sprite) return p.sprite < q.sprite;
+        return p.y != q.y ? p.y < q.y : p.x < q.x;
+    });
+    b.drawn = 0;
+    for (size_t i=0;i<n;++i){
+        const SpriteDraw &d = b.items[i];
+        if (i && d.sprite==b.items[i-1].sprite && d.x==b.items[i-1].x && d.y==b.items[i-1].y) continue;
+        draw_bitmap(a.sheet, d.x, d.y, a.part[d.sprite]);
+        ++b.drawn;
+    }
+    b.items.clear();
 }
 
-void update_mover(Mover &m, float dt)
+// ---------- chunked static layer ----------
+// The maze floor and walls, cached in CHUNK_TILES² bitmaps. A chunk is only
+// painted when it first comes into view and is recycled once it is more than
+// one chunk outside it, so memory and draw cost follow the viewport, not the maze.
+struct ChunkCache {
+    int chunk{16};                 // tiles per chunk side
+    int rows{0}, cols{0};          // chunks per maze side
+    vector<bitmap> slot;           // per chunk; nullptr until painted
+    vector<int>    live;           // chunk ids holding a bitmap
+    vector<bitmap> spare;          // recycled bitmaps, all chunk*TILE px square
+    int created{0};
+};
+
+// forget the old maze; bitmaps are kept for reuse
+void reset_chunks(ChunkCache &cc, const MazeGrid &g, int chunk)
 {
-    if (!m.moving) return;
-    m.t += (m.speed * dt) / (float)TILE;
-    if (m.t >= 1.0f) {
-        m.t = 1.0f; m.moving=false;
-        m.r = m.tr; m.c = m.tc;
-        m.x = m.tx; m.y = m.ty;
-    } else {
-        m.x = m.sx + (m.tx - m.sx) * m.t;
-        m.y = m.sy + (m.ty - m.sy) * m.t;
-    }
+    for (int id : cc.live) cc.spare.push_back(cc.slot[id]);
+    cc.live.clear();
+    cc.chunk = std::max(1, chunk);
+    cc.rows = (g.H + cc.chunk - 1) / cc.chunk;
+    cc.cols = (g.W + cc.chunk - 1) / cc.chunk;
+    cc.slot.assign((size_t)cc.rows*cc.cols, nullptr);
 }
 
-// A*: return next step
-pair<int,int> astar_next_step(const vector<vector<int>>& g, pair<int,int> s, pair<int,int> t)
+void paint_chunk(ChunkCache &cc, int id, const MazeGrid &g, const SpriteAtlas &atlas)
 {
-    if (s==t) return s;
-    const int H = (int)g.size(), W = (int)g[0].size();
-    auto inb = [&](int r,int c){ return 0<=r && r<H && 0<=c && c<W; };
-    auto h   = [&](int r,int c){ return std::abs(r-t.first)+std::abs(c-t.second); };
-    static const int DR[4]={-1,1,0,0};
-    static const int DC[4]={0,0,-1,1};
-
-    struct Node{int r,c,g,f;};
-    struct Cmp{
-        bool operator()(const Node&a, const Node&b)const{
-            return (a.f>b.f) || (a.f==b.f && a.g>b.g);
-        }
-    };
-
-    std::vector<std::vector<int>> gscore(H, std::vector<int>(W, 1<<29));
-    std::vector<std::vector<pair<int,int>>> came(H, std::vector<pair<int,int>>(W, {-1,-1}));
-    std::priority_queue<Node, std::vector<Node>, Cmp> pq;
-
-    gscore[s.first][s.second]=0;
-    pq.push({s.first,s.second,0,h(s.first,s.second)});
-
-    while(!pq.empty()){
-        auto cur = pq.top(); pq.pop();
-        if (cur.r==t.first && cur.c==t.second) break;
-        for(int k=0;k<4;++k){
-            int rr=cur.r+DR[k], cc=cur.c+DC[k];
-            if(!inb(rr,cc) || g[rr][cc]==WALL) continue;
-            int ng=cur.g+1;
-            if (ng<gscore[rr][cc]){
-                gscore[rr][cc]=ng;
-                came[rr][cc]={cur.r,cur.c};
-                int nf=ng+h(rr,cc);
-                pq.push({rr,cc,ng,nf});
-            }
-        }
+    bitmap bmp;
+    if (!cc.spare.empty()){ bmp = cc.spare.back(); cc.spare.pop_back(); }
+    else bmp = create_bitmap("maze_chunk_" + std::to_string(cc.created++), cc.chunk*TILE, cc.chunk*TILE);
+    clear_bitmap(bmp, COLOR_BLACK);
+
+    const int r0 = (id / cc.cols) * cc.chunk, c0 = (id % cc.cols) * cc.chunk;
+    const int r1 = std::min(g.H, r0 + cc.chunk), c1 = std::min(g.W, c0 + cc.chunk);
+    for (int r=r0;r<r1;++r) for (int c=c0;c<c1;++c){
+        float x=(float)((c-c0)*TILE), y=(float)((r-r0)*TILE);
+        draw_bitmap_on_bitmap(bmp, atlas.sheet, x,y, atlas.part[SPR_FLOOR]);
+        if (g.at(r,c)==WALL) draw_bitmap_on_bitmap(bmp, atlas.sheet, x,y, atlas.part[SPR_WALL]);
     }
+    cc.slot[id] = bmp;
+    cc.live.push_back(id);
+}
 
-    auto target=t;
-    if (came[target.first][target.second].first==-1){ // unreachable
-        int bestf=1<<30; pair<int,int> best=s;
-        for(int r=0;r<H;++r) for(int c=0;c<W;++c){
-            if (gscore[r][c]<(1<<29)){
-                int f=gscore[r][c]+h(r,c);
-                if (f<bestf){bestf=f; best={r,c};}
-            }
-        }
-        target=best; if (target==s) return s;
+// blit the chunks covering `view`, painting missing ones and recycling far ones
+void draw_chunks(ChunkCache &cc, const MazeGrid &g, const SpriteAtlas &atlas, const TileRange &view)
+{
+    if (view.r1<=view.r0 || view.c1<=view.c0) return;
+    const int kr0=view.r0/cc.chunk, kr1=(view.r1-1)/cc.chunk;
+    const int kc0=view.c0/cc.chunk, kc1=(view.c1-1)/cc.chunk;
+    for (int kr=kr0;kr<=kr1;++kr) for (int kc=kc0;kc<=kc1;++kc){
+        int id = kr*cc.cols + kc;
+        if (!cc.slot[id]) paint_chunk(cc, id, g, atlas);
+        draw_bitmap(cc.slot[id], cell_to_px_c(kc*cc.chunk), cell_to_px_r(kr*cc.chunk));
     }
-    // backtrack to s; take next step
-    pair<int,int> cur=target;
-    vector<pair<int,int>> path;
-    while(!(cur==s)){
-        path.push_back(cur);
-        auto p=came[cur.first][cur.second];
-        if (p.first==-1) break;
-        cur=p;
+    for (size_t i=0;i<cc.live.size();){                      // swap-and-pop eviction
+        int id=cc.live[i], kr=id/cc.cols, kc=id%cc.cols;
+        if (kr<kr0-1 || kr>kr1+1 || kc<kc0-1 || kc>kc1+1){
+            cc.spare.push_back(cc.slot[id]); cc.slot[id]=nullptr;
+            cc.live[i]=cc.live.back(); cc.live.pop_back();
+        } else ++i;
     }
-    if (path.empty()) return s;
-    return path.back();
 }
 
-// coin
-struct Coin { int r{0}, c{0}; bool collected{false}; };
-
-inline bool walkable(const vector<vector<int>>& g, int r, int c){
-    return 0<=r && r<(int)g.size() && 0<=c && c<(int)g[0].size() && g[r][c]==ROAD;
+void free_chunks(ChunkCache &cc)
+{
+    for (int id : cc.live) cc.spare.push_back(cc.slot[id]);
+    for (bitmap b : cc.spare) if (bitmap_valid(b)) free_bitmap(b);
+    cc.live.clear(); cc.spare.clear(); cc.slot.clear();
 }
 
-int main()
+// usage: ./main [--record replay.mzr] [--seed S]
+// --record logs every round for ./headless --replay; --seed replaces
+// std::random_device so the mazes and spawns repeat too
+int main(int argc, char **argv)
 {
+    std::string record_path;
+    bool fixed_seed = false;
+    uint32_t seed = 0;
+    for (int i=1;i+1<argc;i+=2){
+        std::string k=argv[i], v=argv[i+1];
+        if      (k=="--record") record_path = v;
+        else if (k=="--seed")   { seed = (uint32_t)std::stoul(v); fixed_seed = true; }
+        else { std::cerr<<"unknown option: "<<k<<"\n"; return 2; }
+    }
+
     try{
-        // 若一开始没有 maze.json，则先自动生成一张
-        const std::string maze_path = "maze.json";
+        // 若一开始没有 maze.mzb / maze.json，则直接在内存里生成一张
+        const std::string maze_path = file_exists("maze.mzb") ? "maze.mzb" : "maze.json";
         // 你想要的默认尺寸（建议奇数更规整）；可按需改
         const int GEN_H = 25;
         const int GEN_W = 25;
 
-        if (!file_exists(maze_path)) {
-            // 可选：给个随机 seed，保证每次首次运行都不同
-            std::random_device rd; std::mt19937 rng(rd());
-            int seed = std::uniform_int_distribution<int>(0, 1'000'000'000)(rng);
-
-            bool ok = generate_maze_via_python(maze_path, GEN_H, GEN_W, seed);
-            if (!ok) {
-                std::cerr << "ERROR: maze.json not found, and auto-generation failed. "
-                            "Make sure generator.py is next to the executable.\n";
-                return 1;
-            }
+        std::random_device rd; std::mt19937 rng(fixed_seed ? seed : rd());
+
+        // the first round comes from maze.json when present
+        RoundLayout first;
+        if (file_exists(maze_path)) {
+            first.maze = load_maze(maze_path);
+        } else {
+            MazeGenOptions gen;
+            gen.H = GEN_H; gen.W = GEN_W;
+            gen.seed = rng();
+            gen.loop_density = LOOP_DENSITY;
+            generate_single_exit_maze(first.maze, gen);
+            first.gen = gen; first.generated = true;
         }
-
-        // 现在一定有 maze.json 了，再加载
-        auto maze = load_maze(maze_path);
+        place_actors(first, NUM_MONSTERS, NUM_COINS, rng);
 
         // initial maze load (you can create one with: python generator.py generate)
-        const int INIT_H=(int)maze.size(), INIT_W=(int)maze[0].size();
+        const int INIT_H=first.maze.H, INIT_W=first.maze.W;
 
-        // window built for initial size; we keep H/W constant when regenerating
-        const int SCR_W = INIT_W*TILE + PADDING*2;
-        const int SCR_H = INIT_H*TILE + PADDING*2;
+        // the window is a fixed viewport onto the maze; we keep H/W constant when regenerating
+        const int WORLD_W = INIT_W*TILE + PADDING*2;
+        const int WORLD_H = INIT_H*TILE + PADDING*2;
+        const int SCR_W = std::min(WORLD_W, VIEW_TILES_W*TILE);
+        const int SCR_H = std::min(WORLD_H, VIEW_TILES_H*TILE);
         open_window("Maze + Coins", SCR_W, SCR_H);
 
-        // textures
-        bitmap floor_bmp   = load_bitmap("floor",   "Floor.bmp");
-        bitmap wall_bmp    = load_bitmap("wall",    "Wall.bmp");
-        bitmap player_bmp  = load_bitmap("player",  "Player.bmp");
-        bitmap monster_bmp = load_bitmap("monster", "Monster.png");
-        bitmap gold_bmp    = load_bitmap("gold",    "Gold.png");
-
-        // scales
-        drawing_options opt_floor   = make_tile_scale(floor_bmp);
-        drawing_options opt_wall    = make_tile_scale(wall_bmp);
-        drawing_options opt_player  = make_tile_scale(player_bmp);
-        drawing_options opt_monster = make_tile_scale(monster_bmp);
-        drawing_options opt_gold    = make_tile_scale(gold_bmp);
-
-        std::random_device rd; std::mt19937 rng(rd());
-
-        auto exit_cell = find_single_exit(maze);
-        auto pspawn = random_road(maze, rng);
-        auto mspawn = random_road(maze, rng);
-        while (mspawn==pspawn || mspawn==exit_cell) mspawn = random_road(maze, rng);
-
-        Mover player, monster;
-        place_at_cell(player,  pspawn.first, pspawn.second);
-        place_at_cell(monster, mspawn.first, mspawn.second);
-        player.speed  = PLAYER_SPEED;
-        monster.speed = MONSTER_SPEED;
-
-        vector<Coin> coins;
-        int coins_collected = 0;
-        int score = 0;
-
+        // textures: all five sprites, pre-scaled to TILE, in one atlas
+        SpriteAtlas atlas;
+        build_atlas(atlas);
+        SpriteBatch batch;
+
+        // static layer: floor and walls only change with the maze, so they are
+        // cached in chunk bitmaps painted as they scroll into view
+        ChunkCache chunks;
+        Camera cam; cam.view_w = SCR_W; cam.view_h = SCR_H;
+
+        // the rules run in game_sim.hpp at a fixed SIM_HZ, in cells and seconds
+        SimConfig cfg;
+        cfg.dt            = 1.0f / SIM_HZ;
+        cfg.player_speed  = PLAYER_SPEED / TILE;
+        cfg.monster_speed = MONSTER_SPEED / TILE;
+        cfg.pick_radius   = PICK_RADIUS;
+        cfg.coin_value    = COIN_VALUE;
+        cfg.replan_drift  = AI_REPLAN_DRIFT;
+        cfg.engine        = AI_ENGINE;
+
+        GameState game;
+        const MazeGrid &maze = game.maze;
+
+        // input log: the layout of every round plus one run per input change
+        ReplayWriter rec;
+        if (!record_path.empty()) open_replay(rec, record_path, cfg);
 
         int  last_coins_collected = 0;
         int  last_score = 0;
         bool end_stats_ready = false;
 
-        auto respawn_coins = [&](const pair<int,int>& p, const pair<int,int>& m){
-            std::set<pair<int,int>> used{p, m, exit_cell};
-            coins.clear();
-            for (int i=0;i<NUM_COINS;++i){
-                auto cs = random_road(maze, rng);
-                while (used.count(cs)) cs = random_road(maze, rng);
-                used.insert(cs);
-                coins.push_back(Coin{cs.first, cs.second, false});
-            }
-            coins_collected = 0;
-            score = 0;
+        // take over a laid-out round and reset everything else
+        auto start_round = [&](RoundLayout &&L){
+            replay_begin_round(rec, L, cfg.engine);
+            sim_start_round(game, cfg, std::move(L));
+            reset_chunks(chunks, maze, CHUNK_TILES);
+            // 清理结算态
+            end_stats_ready = false;
         };
-        respawn_coins(pspawn, mspawn);
-
-        bool victory=false, game_over=false;
+        start_round(std::move(first));
+
+        // the next maze of the same size is built on a worker while this round runs
+        auto next_gen = [&](){
+            MazeGenOptions gen;
+            gen.H = INIT_H; gen.W = INIT_W;
+            gen.seed = rng();
+            gen.loop_density = LOOP_DENSITY;
+            return gen;
+        };
+        RoundPrefetcher prefetch;
+        prefetch_round(prefetch, next_gen(), NUM_MONSTERS, NUM_COINS);
 
-        // regenerate maze of same size, then reset everything
+        // swap in the prefetched maze, then queue the one after it
         auto reset_round = [&](){
-            int H = INIT_H, W = INIT_W;
-            int seed = std::uniform_int_distribution<int>(0, 1'000'000'000)(rng);
-
-            std::ostringstream cmd;
-            cmd << "python generator.py generate --H " << H
-                << " --W " << W
-                << " --seed " << seed
-                << " --out maze.json";
-            int ret = std::system(cmd.str().c_str());
-            if (ret != 0) { // python3 fallback
-                std::ostringstream cmd2;
-                cmd2 << "python3 generator.py generate --H " << H
-                     << " --W " << W
-                     << " --seed " << seed
-                     << " --out maze.json";
-                ret = std::system(cmd2.str().c_str());
-            }
-            // reload
-            maze = load_maze("maze.json");
-            exit_cell = find_single_exit(maze);
-
-            // respawn characters
-            auto np = random_road(maze, rng);
-            auto nm = random_road(maze, rng);
-            while (nm==np || nm==exit_cell) nm = random_road(maze, rng);
-
-            place_at_cell(player,  np.first, np.second);
-            place_at_cell(monster, nm.first, nm.second);
-
-            respawn_coins(np, nm);
-
-            // 清理结算态
-            victory=false; game_over=false;
-            end_stats_ready = false;
+            start_round(take_round(prefetch));
+            prefetch_round(prefetch, next_gen(), NUM_MONSTERS, NUM_COINS);
         };
 
         auto t0 = std::chrono::high_resolution_clock::now();
+        float acc = 0.0f;   // real time not yet simulated
+
+#ifdef MAZE_PROFILE
+        // F1 toggles the timers and their overlay; percentiles refresh every 15 frames
+        profiler().trace = PROFILE_TRACE[0] != '\0';
+        bool show_profile = true;
+        int  profile_frame = 0;
+        double prof_p50[PH_COUNT] = {}, prof_p99[PH_COUNT] = {};
+#endif
 
         while (!window_close_requested("Maze + Coins"))
         {
-            process_events();
+            SimInput in;
+            {
+                PROF_SCOPE(PH_INPUT);
+                process_events();
+
+                // held direction, applied by every tick this frame
+                if (key_down(W_KEY) || key_down(UP_KEY))         in.dr=-1;
+                else if (key_down(S_KEY) || key_down(DOWN_KEY))  in.dr=+1;
+                else if (key_down(A_KEY) || key_down(LEFT_KEY))  in.dc=-1;
+                else if (key_down(D_KEY) || key_down(RIGHT_KEY)) in.dc=+1;
+                // TAB cycles the monster pathfinding engine
+                if (key_typed(TAB_KEY)){
+                    replay_engine_switch(rec);
+                    sim_set_engine(game, cfg, (AiEngine)((cfg.engine+1) % AI_ENGINE_COUNT));
+                }
+#ifdef MAZE_PROFILE
+                if (key_typed(F1_KEY)){ show_profile = !show_profile; profiler().enabled = show_profile; }
+#endif
+            }
 
-            // dt
+            // dt, clamped so a stall (window drag, breakpoint) cannot queue a burst of ticks
             auto t1 = std::chrono::high_resolution_clock::now();
             float dt = std::chrono::duration<float>(t1 - t0).count();
             t0 = t1;
+            acc += std::min(dt, MAX_FRAME_DT);
 
-            // input -> grid move
-            if (!player.moving && !victory && !game_over){
-                int dr=0, dc=0;
-                if (key_down(W_KEY) || key_down(UP_KEY))         dr=-1;
-                else if (key_down(S_KEY) || key_down(DOWN_KEY))  dr=+1;
-                else if (key_down(A_KEY) || key_down(LEFT_KEY))  dc=-1;
-                else if (key_down(D_KEY) || key_down(RIGHT_KEY)) dc=+1;
-                int nr=player.r+dr, nc=player.c+dc;
-                if ((dr||dc) && walkable(maze,nr,nc)){
-                    start_move(player, nr,nc);
-                }
-            }
-
-            // monster AI
-            if (!monster.moving && !victory && !game_over){
-                auto step = astar_next_step(maze, {monster.r,monster.c}, {player.r,player.c});
-                if (step != pair<int,int>{monster.r,monster.c}) {
-                    start_move(monster, step.first, step.second);
-                }
-            }
-
-            // tween updates
-            if (!victory && !game_over){
-                update_mover(player,  dt);
-                update_mover(monster, dt);
-            }
-
-            // coin pickup by player
-            if (!victory && !game_over){
-                float px = player.x + TILE*0.5f;
-                float py = player.y + TILE*0.5f;
-                float rad = PICK_RADIUS * TILE;
-                float rad2 = rad*rad;
-                for (auto &coin : coins){
-                    if (coin.collected) continue;
-                    float cx = cell_to_px_c(coin.c) + TILE*0.5f;
-                    float cy = cell_to_px_r(coin.r) + TILE*0.5f;
-                    float dx = px-cx, dy=py-cy;
-                    if (dx*dx+dy*dy <= rad2){
-                        coin.collected=true;
-                        ++coins_collected;
-                        score += COIN_VALUE;
-                    }
-                }
+            // fixed-timestep simulation: input, monster AI, tweens, coins, win/lose
+            while (acc >= cfg.dt){
+                replay_tick(rec, game, in);
+                sim_tick(game, cfg, in);
+                acc -= cfg.dt;
             }
+            const float alpha = acc / cfg.dt;   // progress into the next tick
 
-            // win/lose checks
-            if (!victory && !game_over){
-                if (!player.moving && player.r==exit_cell.first && player.c==exit_cell.second){
-                    victory = true;
-                }
-                if (!player.moving && !monster.moving && player.r==monster.r && player.c==monster.c){
-                    game_over = true;
-                }
-            }
+            const bool playing = !round_over(game);
 
             // 一旦进入结算，冻结本局统计，后续不再变
-            if ((victory || game_over) && !end_stats_ready){
-                last_coins_collected = coins_collected;
-                last_score = score;
+            if (!playing && !end_stats_ready){
+                last_coins_collected = game.coins_collected;
+                last_score = game.score;
                 end_stats_ready = true;
+                replay_end_round(rec, game);
             }
 
             // render
             clear_screen(COLOR_BLACK);
 
-            // map
-            int H=(int)maze.size(), W=(int)maze[0].size();
-            for (int r=0;r<H;++r) for(int c=0;c<W;++c){
-                float x=cell_to_px_c(c), y=cell_to_px_r(r);
-                if (bitmap_valid(floor_bmp)) draw_bitmap(floor_bmp, x,y, opt_floor);
-                else fill_rectangle(COLOR_GRAY, x,y, TILE,TILE);
-                if (maze[r][c]==WALL){
-                    if (bitmap_valid(wall_bmp)) draw_bitmap(wall_bmp, x,y, opt_wall);
-                    else fill_rectangle(COLOR_DARK_GREEN, x,y, TILE,TILE);
-                }
+            // camera follows the player; everything below is drawn in world px
+            // and culled to the visible tiles
+            const Mover &player = game.player;
+            const float pl_x = mover_px_x(player, alpha), pl_y = mover_px_y(player, alpha);
+            center_camera(cam, pl_x + TILE*0.5f, pl_y + TILE*0.5f, WORLD_W, WORLD_H);
+            const TileRange view = visible_tiles(cam, maze);
+
+            // map: cached chunks under the viewport
+            {
+                PROF_SCOPE(PH_DRAW_MAP);
+                draw_chunks(chunks, maze, atlas, view);
             }
 
-            // coins (only in play)
-            if (!victory && !game_over){
-                for (const auto &coin: coins){
-                    if (coin.collected) continue;
-                    float x=cell_to_px_c(coin.c), y=cell_to_px_r(coin.r);
-                    if (bitmap_valid(gold_bmp)) draw_bitmap(gold_bmp, x,y, opt_gold);
-                    else fill_circle(COLOR_YELLOW, x+TILE*0.5f, y+TILE*0.5f, TILE*0.30f);
+            {
+                PROF_SCOPE(PH_DRAW_SPRITES);
+                // coins (only in play): per-cell lookups over the visible tiles,
+                // independent of how many coins the round has
+                if (playing){
+                    for (int r=view.r0;r<view.r1;++r) for (int c=view.c0;c<view.c1;++c)
+                        if (coin_at(game.coins, maze, r, c)>=0) batch_sprite(batch, SPR_GOLD, cell_to_px_c(c), cell_to_px_r(r));
                 }
-            }
 
-            // actors
-            if (bitmap_valid(player_bmp)) draw_bitmap(player_bmp, player.x, player.y, opt_player);
-            else fill_rectangle(COLOR_BLUE, player.x, player.y, TILE,TILE);
-            if (bitmap_valid(monster_bmp)) draw_bitmap(monster_bmp, monster.x, monster.y, opt_monster);
-            else fill_rectangle(COLOR_RED, monster.x, monster.y, TILE,TILE);
+                // actors, interpolated between the last two ticks
+                batch_sprite(batch, SPR_PLAYER, pl_x, pl_y);
+                for (const auto &monster : game.monsters)
+                    batch_sprite(batch, SPR_MONSTER, mover_px_x(monster, alpha), mover_px_y(monster, alpha));
+                flush_batch(batch, atlas, cam);
+            }
 
-            // HUD during play
-            if (!victory && !game_over){
-                std::ostringstream hud; hud<<"Coins "<<coins_collected<<"/"<<NUM_COINS<<"   Score "<<score;
-                draw_text(hud.str(), COLOR_WHITE, "arial", 18, 8, 8);
+            // HUD during play (screen space)
+            if (playing){
+                PROF_SCOPE(PH_HUD);
+                std::ostringstream hud; hud<<"Coins "<<game.coins_collected<<"/"<<game.coins.total<<"   Score "<<game.score<<"   AI "<<AI_ENGINE_NAME[cfg.engine];
+                draw_text(hud.str(), COLOR_WHITE, "arial", 18, 8, 8, option_to_screen());
+#ifdef MAZE_PROFILE
+                // profiler overlay: p50 / p99 per phase over the last FrameProfiler::FRAMES frames
+                if (show_profile){
+                    if (profile_frame++ % 15 == 0) prof_percentiles(prof_p50, prof_p99);
+                    for (int k=0;k<PH_COUNT;++k){
+                        std::ostringstream ln;
+                        ln.setf(std::ios::fixed); ln.precision(3);
+                        ln<<PROF_PHASE_NAME[k]<<"  p50 "<<prof_p50[k]<<"  p99 "<<prof_p99[k]<<" ms";
+                        draw_text(ln.str(), COLOR_YELLOW, "arial", 14, 8, 32 + 16*k, option_to_screen());
+                    }
+                }
+#endif
             }
 
             // end screens (use FROZEN stats)
-            if (victory || game_over){
+            if (!playing){
                 clear_screen(color_black());
-                if (victory){
-                    draw_text("YOU WIN!", COLOR_RED, "arial", 32, 12, 10);
-                    draw_text("Press Y: next / N: quit", COLOR_WHITE, "arial", 22, 12, 50);
+                if (game.victory){
+                    draw_text("YOU WIN!", COLOR_RED, "arial", 32, 12, 10, option_to_screen());
+                    draw_text("Press Y: next / N: quit", COLOR_WHITE, "arial", 22, 12, 50, option_to_screen());
                 } else {
-                    draw_text("GAME OVER", COLOR_RED, "arial", 32, 12, 10);
-                    draw_text("Press Y: retry / N: quit", COLOR_WHITE, "arial", 22, 12, 50);
+                    draw_text("GAME OVER", COLOR_RED, "arial", 32, 12, 10, option_to_screen());
+                    draw_text("Press Y: retry / N: quit", COLOR_WHITE, "arial", 22, 12, 50, option_to_screen());
                 }
                 std::ostringstream ss;
                 ss << "Coins: " << last_coins_collected << "   Score: " << last_score;
-                draw_text(ss.str(), COLOR_RED, "arial", 22, 12, 86);
+                draw_text(ss.str(), COLOR_RED, "arial", 22, 12, 86, option_to_screen());
 
                 if (key_typed(Y_KEY))      reset_round();
                 else if (key_typed(N_KEY) || key_typed(ESCAPE_KEY)) break;
             }
 
-            refresh_screen(FPS_LIMIT);
+            {
+                PROF_SCOPE(PH_PRESENT);
+                refresh_screen(FPS_LIMIT);
+            }
+            prof_end_frame();
         }
+        close_replay(rec, game);   // a round still in play is logged as unfinished
+
+#ifdef MAZE_PROFILE
+        if (PROFILE_TRACE[0] && !prof_dump_trace(PROFILE_TRACE))
+            std::cerr<<"cannot write trace: "<<PROFILE_TRACE<<"\n";
+#endif
 
         // free bitmaps
-        if (bitmap_valid(floor_bmp))   free_bitmap(floor_bmp);
-        if (bitmap_valid(wall_bmp))    free_bitmap(wall_bmp);
-        if (bitmap_valid(player_bmp))  free_bitmap(player_bmp);
-        if (bitmap_valid(monster_bmp)) free_bitmap(monster_bmp);
-        if (bitmap_valid(gold_bmp))    free_bitmap(gold_bmp);
+        free_chunks(chunks);
+        free_atlas(atlas);
 
     }catch(const std::exception& e){
         std::cerr<<"ERROR: "<<e.what()<<"\n";
@@ -0,0 +1,148 @@
+// maze_gen.hpp — in-process port of generator.py's generate_single_exit_maze
+#ifndef MAZE_GEN_HPP
+#define MAZE_GEN_HPP
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+
+#include "maze_grid.hpp"
+
+enum ExitSide { EXIT_ANY, EXIT_BOTTOM, EXIT_RIGHT };
+
+struct MazeGenOptions {
+    int      H{20}, W{20};          // recommended odd >= 5
+    uint32_t seed{0};
+    ExitSide exit_side{EXIT_ANY};   // EXIT_ANY picks bottom or right at random
+    float    loop_density{0.08f};   // fraction [0, 0.5] of loop walls knocked out
+};
+
+// exactly one border ROAD cell, and it is exit_rc on the bottom or right edge
+inline bool check_single_exit(const MazeGrid &g, std::pair<int,int> exit_rc)
+{
+    const int H=g.H, W=g.W, er=exit_rc.first, ec=exit_rc.second;
+    if (!((er==H-1 && 0<=ec && ec<W) || (ec==W-1 && 0<=er && er<H))) return false;
+    int roads=0;
+    for (int c=0;c<W;++c) roads += (g.at(0,c)==ROAD) + (g.at(H-1,c)==ROAD);
+    for (int r=0;r<H;++r) roads += (g.at(r,0)==ROAD) + (g.at(r,W-1)==ROAD);
+    return roads==1;
+}
+
+namespace maze_gen_detail {
+
+// Rebuild the hard outer boundary, then open one exit on the bottom or right
+// edge, aligned with an interior ROAD cell; carve a tunnel inwards first if
+// the adjacent row/column has none. Shared by every generator.
+inline std::pair<int,int> seal_and_open_exit(MazeGrid &g, const MazeGenOptions &opt, std::mt19937 &rng)
+{
+    const int H=g.H, W=g.W;
+
+    // rebuild hard outer boundary
+    for (int c=0;c<W;++c){ g.set(0,c,WALL); g.set(H-1,c,WALL); }
+    for (int r=0;r<H;++r){ g.set(r,0,WALL); g.set(r,W-1,WALL); }
+
+    // exit placement
+    ExitSide side = opt.exit_side;
+    if (side==EXIT_ANY) side = std::uniform_int_distribution<int>(0,1)(rng) ? EXIT_RIGHT : EXIT_BOTTOM;
+
+    std::vector<int> open;
+    std::pair<int,int> exit_rc;
+    if (side==EXIT_BOTTOM){
+        for (int c=1;c<W-1;++c) if (g.at(H-2,c)==ROAD) open.push_back(c);
+        if (open.empty()){
+            int c=std::uniform_int_distribution<int>(1,W-2)(rng);
+            for (int r=H-2; r>=1 && g.at(r,c)!=ROAD; --r) g.set(r,c,ROAD);
+            open.push_back(c);
+        }
+        int c=open[std::uniform_int_distribution<size_t>(0,open.size()-1)(rng)];
+        g.set(H-1,c,ROAD);
+        exit_rc={H-1,c};
+    } else {
+        for (int r=1;r<H-1;++r) if (g.at(r,W-2)==ROAD) open.push_back(r);
+        if (open.empty()){
+            int r=std::uniform_int_distribution<int>(1,H-2)(rng);
+            for (int c=W-2; c>=1 && g.at(r,c)!=ROAD; --c) g.set(r,c,ROAD);
+            open.push_back(r);
+        }
+        int r=open[std::uniform_int_distribution<size_t>(0,open.size()-1)(rng)];
+        g.set(r,W-1,ROAD);
+        exit_rc={r,W-1};
+    }
+
+    if (!check_single_exit(g, exit_rc))
+        throw std::runtime_error("generated maze does not have exactly one exit");
+    return exit_rc;
+}
+
+} // namespace maze_gen_detail
+
+// Carve a single-exit maze straight into g, same steps as generator.py:
+// DFS backtracker on the odd lattice, loop walls knocked out, hard border,
+// then one exit on the bottom or right edge. Returns the exit cell.
+inline std::pair<int,int> generate_single_exit_maze(MazeGrid &g, const MazeGenOptions &opt)
+{
+    const int H=opt.H, W=opt.W;
+    if (H<5 || W<5) throw std::runtime_error("maze must be at least 5x5");
+    std::mt19937 rng(opt.seed);
+    const float loop_density = std::max(0.0f, std::min(0.5f, opt.loop_density));
+
+    init_grid(g, H, W, WALL);
+
+    // carve "rooms" on the odd grid
+    for (int r=1;r<H-1;r+=2) for (int c=1;c<W-1;c+=2) g.set(r,c,ROAD);
+
+    // DFS carve from (1,1), jumping two cells between odd lattice points.
+    // Everything that is not a room starts out "seen", so the two-cell jump
+    // needs no bounds test: it lands on the wall border at worst.
+    std::vector<uint8_t> seen(g.cells.size(), 1);
+    for (int r=1;r<H-1;r+=2) for (int c=1;c<W-1;c+=2) seen[g.index(r,c)]=0;
+    std::vector<int> stack; stack.reserve((size_t)(H/2)*(W/2));
+    auto pick = [&](int n){ return (int)(((uint64_t)rng() * (uint32_t)n) >> 32); };
+
+    stack.push_back(g.index(1,1)); seen[stack.back()]=1;
+    while (!stack.empty()){
+        const int cur=stack.back();
+        int nbrs[4], n=0;
+        for (int k=0;k<4;++k){                     // branchless: the picks are random
+            nbrs[n]=k; n+=!seen[cur+2*g.step[k]];
+        }
+        if (n==0){ stack.pop_back(); continue; }   // backtrack
+
+        int k=nbrs[n==1 ? 0 : pick(n)];
+        int nxt=cur+2*g.step[k];
+        g.cells[cur+g.step[k]]=ROAD;              // wall between the two rooms
+        seen[nxt]=1;
+        stack.push_back(nxt);
+    }
+
+    // knock out a share of the walls that separate two opposite ROAD cells
+    std::vector<int> cand;
+    size_t ncand=0;
+    if (loop_density>0.0f){
+        cand.resize((size_t)(H-2)*(W-2));
+        const uint8_t *cell=g.cells.data();
+        for (int r=1;r<H-1;++r){
+            int i=g.index(r,1);
+            for (int c=1;c<W-1;++c,++i){            // branchless append
+                int pass = ((cell[i-1]==ROAD) & (cell[i+1]==ROAD)) |
+                           ((cell[i-g.stride]==ROAD) & (cell[i+g.stride]==ROAD));
+                cand[ncand]=i;
+                ncand += (cell[i]==WALL) & pass;
+            }
+        }
+        cand.resize(ncand);
+    }
+    const size_t k=(size_t)(ncand*loop_density);
+    for (size_t i=0;i<k;++i){                    // partial Fisher-Yates: first k picks
+        size_t j=std::uniform_int_distribution<size_t>(i, cand.size()-1)(rng);
+        std::swap(cand[i], cand[j]);
+        g.cells[cand[i]]=ROAD;
+    }
+
+    return maze_gen_detail::seal_and_open_exit(g, opt, rng);
+}
+
+#endif // MAZE_GEN_HPP
@@ -0,0 +1,214 @@
+// maze_gen_tiled.hpp — parallel single-exit maze generation for huge maps
+#ifndef MAZE_GEN_TILED_HPP
+#define MAZE_GEN_TILED_HPP
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <utility>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+
+#include "maze_grid.hpp"
+#include "maze_gen.hpp"
+#include "work_steal.hpp"
+
+// The odd-cell room lattice is cut into tile_rooms x tile_rooms tiles.
+//  1. every tile is carved by its own DFS backtracker (a spanning tree of
+//     its rooms), on any thread, from a seed derived from (seed, tile);
+//  2. Kruskal over the tile adjacency graph with shuffled edges picks a
+//     random spanning tree of tiles, and each chosen edge opens one wall
+//     on that tile border: spanning trees joined by a spanning tree make a
+//     perfect maze over the whole lattice;
+//  3. loop walls are chosen per tile against the joined maze, then knocked
+//     out, again in parallel;
+//  4. border and exit as in generate_single_exit_maze.
+// Tiles only write their own cells, and nothing depends on which thread ran
+// which tile, so the maze is a function of (options, tile_rooms) alone: the
+// same for any thread count. Memory beyond the grid is one tile of DFS state
+// per worker.
+
+struct TiledMazeOptions {
+    unsigned threads{1};
+    int      tile_rooms{128};      // tile side in rooms (2 cells per room)
+};
+
+namespace maze_tiled_detail {
+
+// distinct rng stream per tile and pass (splitmix64 finaliser)
+inline uint32_t tile_seed(uint32_t seed, uint64_t tile, uint64_t pass)
+{
+    uint64_t z = ((uint64_t)seed << 32) ^ (tile * 0x9E3779B97F4A7C15ull) ^ (pass << 56);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)(z ^ (z >> 31));
+}
+
+struct Tiling {
+    int rooms_r{0}, rooms_c{0};    // lattice size in rooms
+    int side{1};                   // tile side in rooms
+    int tiles_r{0}, tiles_c{0};
+    int count() const { return tiles_r * tiles_c; }
+    // room range [i0,i1) x [j0,j1) of tile t
+    void rooms(int t, int &i0, int &i1, int &j0, int &j1) const {
+        i0 = (t / tiles_c) * side; i1 = std::min(rooms_r, i0 + side);
+        j0 = (t % tiles_c) * side; j1 = std::min(rooms_c, j0 + side);
+    }
+};
+
+struct TileScratch {
+    std::vector<uint8_t> seen;
+    std::vector<int> stack;
+    std::vector<int> cand;
+};
+
+// DFS backtracker over the rooms of one tile; room (i,j) is cell (2i+1, 2j+1)
+inline void carve_tile(MazeGrid &g, const Tiling &T, int t, uint32_t seed, TileScratch &s)
+{
+    int i0, i1, j0, j1;
+    T.rooms(t, i0, i1, j0, j1);
+    const int th = i1 - i0, tw = j1 - j0;
+    for (int i=i0;i<i1;++i) for (int j=j0;j<j1;++j) g.set(2*i+1, 2*j+1, ROAD);
+
+    std::mt19937 rng(tile_seed(seed, (uint64_t)t, 0));
+    auto pick = [&](int n){ return (int)(((uint64_t)rng() * (uint32_t)n) >> 32); };
+    static const int DI[4] = {-1, +1, 0, 0}, DJ[4] = {0, 0, -1, +1};
+
+    s.seen.assign((size_t)th * tw, 0);
+    s.stack.clear();
+    s.stack.push_back(0); s.seen[0] = 1;
+    while (!s.stack.empty()){
+        const int cur = s.stack.back(), li = cur / tw, lj = cur % tw;
+        int nbrs[4], n = 0;
+        for (int k=0;k<4;++k){
+            const int ni = li + DI[k], nj = lj + DJ[k];
+            if (ni<0 || ni>=th || nj<0 || nj>=tw || s.seen[(size_t)ni*tw + nj]) continue;
+            nbrs[n++] = k;
+        }
+        if (n==0){ s.stack.pop_back(); continue; }   // backtrack
+
+        const int k = nbrs[n==1 ? 0 : pick(n)];
+        const int nxt = (li + DI[k]) * tw + (lj + DJ[k]);
+        g.set(2*(i0+li)+1 + DI[k], 2*(j0+lj)+1 + DJ[k], ROAD);   // wall between the two rooms
+        s.seen[(size_t)nxt] = 1;
+        s.stack.push_back(nxt);
+    }
+}
+
+// Cells a tile owns for the loop pass: the rows/columns from its first
+// room up to the wall line before the next tile (the last tile runs to the border)
+inline void tile_cells(const MazeGrid &g, const Tiling &T, int t, int &r0, int &r1, int &c0, int &c1)
+{
+    int i0, i1, j0, j1;
+    T.rooms(t, i0, i1, j0, j1);
+    r0 = 2*i0 + 1; r1 = (t / T.tiles_c == T.tiles_r-1) ? g.H-1 : 2*i1 + 1;
+    c0 = 2*j0 + 1; c1 = (t % T.tiles_c == T.tiles_c-1) ? g.W-1 : 2*j1 + 1;
+}
+
+// Same rule as generate_single_exit_maze: a WALL with ROAD on both sides
+// along a row or column; only the first k of a per-tile shuffle are kept
+inline void pick_loop_walls(const MazeGrid &g, const Tiling &T, int t, uint32_t seed, float density,
+                            TileScratch &s, std::vector<int> &out)
+{
+    int r0, r1, c0, c1;
+    tile_cells(g, T, t, r0, r1, c0, c1);
+    const uint8_t *cell = g.cells.data();
+    s.cand.clear();
+    for (int r=r0;r<r1;++r){
+        int i = g.index(r, c0);
+        for (int c=c0;c<c1;++c,++i){
+            const bool pass = (cell[i-1]==ROAD && cell[i+1]==ROAD) ||
+                              (cell[i-g.stride]==ROAD && cell[i+g.stride]==ROAD);
+            if (cell[i]==WALL && pass) s.cand.push_back(i);
+        }
+    }
+    std::mt19937 rng(tile_seed(seed, (uint64_t)t, 1));
+    const size_t k = (size_t)(s.cand.size() * density);
+    out.clear();
+    for (size_t i=0;i<k;++i){                    // partial Fisher-Yates: first k picks
+        size_t j = std::uniform_int_distribution<size_t>(i, s.cand.size()-1)(rng);
+        std::swap(s.cand[i], s.cand[j]);
+        out.push_back(s.cand[i]);
+    }
+}
+
+inline int find_root(std::vector<int> &parent, int x)
+{
+    while (parent[(size_t)x] != x){ parent[(size_t)x] = parent[(size_t)parent[(size_t)x]]; x = parent[(size_t)x]; }
+    return x;
+}
+
+} // namespace maze_tiled_detail
+
+// Tiled counterpart of generate_single_exit_maze (same options, same
+// guarantees: every ROAD cell connected, exactly one exit on the bottom or
+// right edge). Returns the exit cell.
+inline std::pair<int,int> generate_tiled_maze(MazeGrid &g, const MazeGenOptions &opt, const TiledMazeOptions &tiled)
+{
+    using namespace maze_tiled_detail;
+    const int H=opt.H, W=opt.W;
+    if (H<5 || W<5) throw std::runtime_error("maze must be at least 5x5");
+    if (tiled.tile_rooms<1) throw std::runtime_error("tile_rooms must be positive");
+    const float loop_density = std::max(0.0f, std::min(0.5f, opt.loop_density));
+    const unsigned threads = std::max(1u, tiled.threads);
+
+    init_grid(g, H, W, WALL);
+
+    Tiling T;
+    T.rooms_r = (H-1)/2; T.rooms_c = (W-1)/2; T.side = tiled.tile_rooms;
+    T.tiles_r = (T.rooms_r + T.side - 1) / T.side;
+    T.tiles_c = (T.rooms_c + T.side - 1) / T.side;
+    const int ntiles = T.count();
+
+    // 1. carve every tile
+    std::vector<TileScratch> scratch(threads);
+    parallel_for_stealing((size_t)ntiles, threads, 1, [&](unsigned w, size_t t){
+        carve_tile(g, T, (int)t, opt.seed, scratch[w]);
+    });
+
+    // 2. join the tiles: Kruskal over shuffled border edges
+    std::mt19937 rng(opt.seed);
+    std::vector<std::pair<int,bool>> edges;     // (tile, joins the tile below rather than right)
+    for (int t=0;t<ntiles;++t){
+        if (t % T.tiles_c != T.tiles_c-1) edges.push_back({t, false});
+        if (t / T.tiles_c != T.tiles_r-1) edges.push_back({t, true});
+    }
+    std::shuffle(edges.begin(), edges.end(), rng);
+    std::vector<int> parent((size_t)ntiles);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (auto e : edges){
+        const int a = e.first, b = e.second ? a + T.tiles_c : a + 1;
+        const int ra = find_root(parent, a), rb = find_root(parent, b);
+        if (ra==rb) continue;
+        parent[(size_t)ra] = rb;
+
+        // open one wall on the shared border, at a random room along it
+        int i0, i1, j0, j1;
+        T.rooms(a, i0, i1, j0, j1);
+        if (!e.second){
+            const int i = std::uniform_int_distribution<int>(i0, i1-1)(rng);
+            g.set(2*i+1, 2*j1, ROAD);
+        } else {
+            const int j = std::uniform_int_distribution<int>(j0, j1-1)(rng);
+            g.set(2*i1, 2*j+1, ROAD);
+        }
+    }
+
+    // 3. loops: pick against the joined maze everywhere first, then knock out
+    if (loop_density>0.0f){
+        std::vector<std::vector<int>> knock((size_t)ntiles);
+        parallel_for_stealing((size_t)ntiles, threads, 1, [&](unsigned w, size_t t){
+            pick_loop_walls(g, T, (int)t, opt.seed, loop_density, scratch[w], knock[t]);
+        });
+        parallel_for_stealing((size_t)ntiles, threads, 1, [&](unsigned, size_t t){
+            for (int i : knock[t]) g.cells[(size_t)i] = ROAD;
+            std::vector<int>().swap(knock[t]);
+        });
+    }
+
+    // 4. hard border and the single exit
+    return maze_gen_detail::seal_and_open_exit(g, opt, rng);
+}
+
+#endif // MAZE_GEN_TILED_HPP
@@ -0,0 +1,296 @@
+// maze_io.hpp — maze files: JSON (maze.json) and the compact binary .mzb format
+#ifndef MAZE_IO_HPP
+#define MAZE_IO_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "nlohmann/json.hpp"
+#include "maze_grid.hpp"
+
+// ---------- .mzb layout (little-endian; readers assume a little-endian host) ----------
+// 32-byte header, then H rows of `words` uint64 each; bit c of a row is
+// 1 for WALL. Rows are word-padded so a row starts on an 8-byte boundary.
+struct MzbHeader {
+    char     magic[4];     // "MZB1"
+    uint32_t version;      // 1
+    int32_t  H, W;
+    int32_t  exit_r, exit_c;
+    uint32_t seed;         // 0 when unknown
+    uint32_t words;        // uint64 words per row = (W+63)/64
+};
+static_assert(sizeof(MzbHeader)==32, "MzbHeader must stay 32 bytes");
+
+// Read-only view of a bit-packed maze; points straight into the mapping.
+struct MazeBits {
+    int H{0}, W{0};
+    int words{0};                  // per row
+    const uint64_t *bits{nullptr};
+
+    bool wall(int r, int c) const { return (bits[(size_t)r*words + (c>>6)] >> (c&63)) & 1u; }
+};
+
+// A memory-mapped .mzb file. The cells stay in the page cache; nothing is
+// copied until a caller unpacks them (see unpack_maze).
+struct MappedMaze {
+    MzbHeader info{};
+    MazeBits  view;
+    void  *base{nullptr};           // mmap'ed file (POSIX)
+    size_t length{0};
+    std::vector<uint64_t> fallback; // whole-file read where mmap is unavailable
+
+    MappedMaze() = default;
+    MappedMaze(const MappedMaze&) = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+    ~MappedMaze() { unmap(); }
+
+    void unmap()
+    {
+#ifndef _WIN32
+        if (base) munmap(base, length);
+#endif
+        base=nullptr; length=0; fallback.clear();
+        view=MazeBits{};
+    }
+};
+
+inline bool has_mzb_magic(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    char m[4]={0,0,0,0};
+    return in.read(m, 4) && std::memcmp(m, "MZB1", 4)==0;
+}
+
+// map a .mzb file and validate its header
+inline void map_maze(MappedMaze &mm, const std::string &path)
+{
+    mm.unmap();
+    const unsigned char *data=nullptr;
+    size_t size=0;
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd<0) throw std::runtime_error("cannot open: " + path);
+    struct stat st;
+    if (fstat(fd, &st)!=0 || st.st_size<(off_t)sizeof(MzbHeader)){
+        ::close(fd); throw std::runtime_error(path + ": not a .mzb maze");
+    }
+    size=(size_t)st.st_size;
+    void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p==MAP_FAILED) throw std::runtime_error("cannot map: " + path);
+    mm.base=p; mm.length=size;
+    data=(const unsigned char*)p;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) throw std::runtime_error("cannot open: " + path);
+    size=(size_t)in.tellg();
+    mm.fallback.resize((size+7)/8);
+    in.seekg(0);
+    in.read((char*)mm.fallback.data(), (std::streamsize)size);
+    data=(const unsigned char*)mm.fallback.data();
+#endif
+    if (size<sizeof(MzbHeader)){ mm.unmap(); throw std::runtime_error(path + ": not a .mzb maze"); }
+    std::memcpy(&mm.info, data, sizeof(MzbHeader));
+    const MzbHeader &h=mm.info;
+    if (std::memcmp(h.magic, "MZB1", 4)!=0 || h.version!=1 || h.H<=0 || h.W<=0 ||
+        h.words!=(uint32_t)((h.W+63)/64) ||
+        size < sizeof(MzbHeader) + (size_t)h.H*h.words*8){
+        mm.unmap();
+        throw std::runtime_error(path + ": bad .mzb header");
+    }
+    mm.view.H=h.H; mm.view.W=h.W; mm.view.words=(int)h.words;
+    mm.view.bits=(const uint64_t*)(data + sizeof(MzbHeader));
+}
+
+// expand the bitmap into the game's byte grid, 8 cells per table lookup
+inline void unpack_maze(const MazeBits &b, MazeGrid &g)
+{
+    static const auto spread = []{            // byte -> 8 cells of 0/1
+        std::array<uint64_t,256> t{};
+        for (int v=0; v<256; ++v)
+            for (int k=0;k<8;++k)
+                if (v>>k & 1) t[v] |= uint64_t(1) << (8*k);   // little-endian cell order
+        return t;
+    }();
+
+    init_grid(g, b.H, b.W, WALL);
+    for (int r=0;r<b.H;++r){
+        const unsigned char *row = (const unsigned char*)(b.bits + (size_t)r*b.words);
+        uint8_t *out = &g.cells[g.index(r,0)];
+        const int full=b.W/8;
+        for (int i=0;i<full;++i) std::memcpy(out + 8*i, &spread[row[i]], 8);
+        for (int c=full*8;c<b.W;++c) out[c]=(uint8_t)((row[c>>3] >> (c&7)) & 1u);
+    }
+}
+
+inline void save_maze_binary(const std::string &path, const MazeGrid &g,
+                             std::pair<int,int> exit_cell, uint32_t seed = 0)
+{
+    MzbHeader h{};
+    std::memcpy(h.magic, "MZB1", 4);
+    h.version=1; h.H=g.H; h.W=g.W;
+    h.exit_r=exit_cell.first; h.exit_c=exit_cell.second;
+    h.seed=seed; h.words=(uint32_t)((g.W+63)/64);
+
+    std::vector<uint64_t> row(h.words);
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("cannot write: " + path);
+    out.write((const char*)&h, sizeof h);
+    for (int r=0;r<g.H;++r){
+        std::fill(row.begin(), row.end(), 0);
+        for (int c=0;c<g.W;++c)
+            if (g.at(r,c)==WALL) row[c>>6] |= uint64_t(1) << (c&63);
+        out.write((const char*)row.data(), (std::streamsize)(row.size()*8));
+    }
+    if (!out) throw std::runtime_error("write failed: " + path);
+}
+
+// SAX handler for maze.json: writes cells straight into the bordered grid
+// buffer as they are parsed and checks row lengths on the fly, so no json
+// DOM is ever built. Errors are reported through `err` (sax_parse stops).
+struct MazeJsonSax {
+    using json = nlohmann::json;
+
+    MazeGrid &g;
+    size_t size_hint;               // file size, bounds the number of cells
+    std::string err{};
+    int depth{0}, rows{0}, col{0};
+    std::vector<uint8_t> first{};   // row 0, buffered until W is known
+
+    bool fail(const char *msg) { err=msg; return false; }
+
+    bool cell(int v)
+    {
+        if (depth!=2) return fail(rows==0 ? "maze.json must be a 2D array"
+                                          : "maze.json rows must all have the same length");
+        uint8_t x = v==ROAD ? (uint8_t)ROAD : (uint8_t)WALL;
+        if (rows==0) first.push_back(x);
+        else if (col>=g.W) return fail("maze.json rows must all have the same length");
+        else g.cells.push_back(x);
+        ++col;
+        return true;
+    }
+
+    bool start_array(std::size_t)
+    {
+        if (++depth>2) return fail("maze.json must be a 2D array");
+        if (depth==2){
+            col=0;
+            if (rows>0) g.cells.push_back((uint8_t)WALL);     // left border
+        }
+        return true;
+    }
+
+    bool end_array()
+    {
+        if (depth==2){
+            if (rows==0){
+                if (first.empty()) return fail("maze size must be positive");
+                g.W=(int)first.size(); g.stride=g.W+2;
+                // at least two bytes per cell in the file; reserving leaves
+                // untouched pages uncommitted, so the grid never reallocates
+                size_t max_rows = size_hint/(2*(size_t)g.W) + 1;
+                g.cells.reserve((max_rows+2)*(size_t)g.stride);
+                g.cells.assign((size_t)g.stride, (uint8_t)WALL);  // top border
+                g.cells.push_back((uint8_t)WALL);
+                g.cells.insert(g.cells.end(), first.begin(), first.end());
+                std::vector<uint8_t>().swap(first);
+            } else if (col!=g.W){
+                return fail("maze.json rows must all have the same length");
+            }
+            g.cells.push_back((uint8_t)WALL);                 // right border
+            ++rows;
+        } else if (depth==1 && rows==0){
+            return fail("maze.json must be a 2D array");
+        }
+        --depth;
+        return true;
+    }
+
+    bool number_integer(json::number_integer_t v)   { return cell((int)v); }
+    bool number_unsigned(json::number_unsigned_t v) { return cell(v==0 ? ROAD : WALL); }
+    bool number_float(json::number_float_t v, const json::string_t&) { return cell((int)v); }
+    bool boolean(bool v) { return cell(v ? 1 : 0); }
+
+    bool null()                      { return fail("maze.json cells must be numbers"); }
+    bool string(json::string_t&)     { return fail("maze.json cells must be numbers"); }
+    bool binary(json::binary_t&)     { return fail("maze.json cells must be numbers"); }
+    bool start_object(std::size_t)   { return fail(depth<2 ? "maze.json must be a 2D array" : "maze.json cells must be numbers"); }
+    bool key(json::string_t&)        { return false; }
+    bool end_object()                { return false; }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception &ex)
+    {
+        err = ex.what();
+        return false;
+    }
+};
+
+// read maze: top-level 2D int array, streamed (peak memory ~ the grid itself)
+inline MazeGrid load_maze_json(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) throw std::runtime_error("cannot open: " + path);
+    size_t size = (size_t)in.tellg();
+    in.seekg(0);
+
+    MazeGrid g;
+    MazeJsonSax sax{g, size};
+    bool ok = nlohmann::json::sax_parse(in, &sax);
+    if (!ok || sax.rows==0)
+        throw std::runtime_error(sax.err.empty() ? "maze.json must be a 2D array" : sax.err);
+
+    g.H = sax.rows;
+    g.cells.insert(g.cells.end(), (size_t)g.stride, (uint8_t)WALL);   // bottom border
+    g.step[0] = -g.stride; g.step[1] = g.stride;
+    g.step[2] = -1;        g.step[3] = 1;
+    return g;
+}
+
+// write maze.json row by row (same layout generator.py writes)
+inline void save_maze_json(const std::string &path, const MazeGrid &g)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("cannot write: " + path);
+    std::string line;
+    line.reserve((size_t)g.W*2 + 4);
+    out.put('[');
+    for (int r=0;r<g.H;++r){
+        line.assign(r ? ",\n [" : "\n [");
+        for (int c=0;c<g.W;++c){
+            if (c) line.push_back(',');
+            line.push_back(g.at(r,c)==WALL ? '1' : '0');
+        }
+        line.push_back(']');
+        out.write(line.data(), (std::streamsize)line.size());
+    }
+    out.write("\n]\n", 3);
+    if (!out) throw std::runtime_error("write failed: " + path);
+}
+
+// .mzb by magic number, anything else is parsed as JSON
+inline MazeGrid load_maze(const std::string &path)
+{
+    if (has_mzb_magic(path)){
+        MappedMaze mm;
+        map_maze(mm, path);
+        MazeGrid g;
+        unpack_maze(mm.view, g);
+        return g;
+    }
+    return load_maze_json(path);
+}
+
+#endif // MAZE_IO_HPP
@@ -0,0 +1,52 @@
+// monster_ai.hpp — per-monster pathfinding state and engine choice
+#ifndef MONSTER_AI_HPP
+#define MONSTER_AI_HPP
+
+#include <utility>
+
+#include "maze_grid.hpp"
+#include "pathfinding.hpp"
+#include "dstar_lite.hpp"
+#include "flow_field.hpp"
+#include "jps.hpp"
+
+enum AiEngine {
+    AI_ASTAR_CACHED,   // A* once, then follow the cached path (PathCache)
+    AI_DSTAR_LITE,     // D* Lite, repaired incrementally as both ends move
+    AI_FLOW_FIELD,     // O(1) lookup in a BFS field shared by all monsters
+    AI_JPS,            // Jump Point Search, a fresh search per step
+    AI_ENGINE_COUNT
+};
+static const char *const AI_ENGINE_NAME[AI_ENGINE_COUNT] = {"A* cached", "D* Lite", "flow field", "JPS"};
+
+// everything one monster needs to chase a target; engines keep their own state
+struct MonsterAI {
+    AiEngine     engine{AI_ASTAR_CACHED};
+    AStarContext astar;
+    PathCache    path;
+    DStarLite    dstar;
+    JpsContext   jps;
+    const FlowField *field{nullptr};   // shared, owned and rebuilt by the game loop
+};
+
+// drop all search state, e.g. after reset_round swapped in a new maze
+inline void reset_ai(MonsterAI &ai)
+{
+    clear_path(ai.path);
+    dstar_reset(ai.dstar);
+    jps_reset(ai.jps);
+}
+
+inline std::pair<int,int> monster_next_step(MonsterAI &ai, const MazeGrid &g,
+                                            std::pair<int,int> s, std::pair<int,int> t)
+{
+    switch (ai.engine){
+        case AI_DSTAR_LITE: return dstar_next_step(g, ai.dstar, s, t);
+        case AI_FLOW_FIELD: return ai.field ? flow_next_step(*ai.field, g, s) : s;
+        case AI_JPS:        return jps_next_step(g, ai.jps, s, t);
+        case AI_ASTAR_CACHED:
+        default:            return cached_next_step(g, ai.astar, ai.path, s, t);
+    }
+}
+
+#endif // MONSTER_AI_HPP
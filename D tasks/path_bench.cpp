@@ -0,0 +1,372 @@
+// path_bench.cpp — cost of every monster pathfinding engine on generated mazes
+// build: clang++ path_bench.cpp -std=c++17 -O2 -pthread -o path_bench
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <queue>
+#include <stdexcept>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+#endif
+
+#include "maze_grid.hpp"
+#include "maze_gen.hpp"
+#include "round_setup.hpp"
+#include "pathfinding.hpp"
+#include "dstar_lite.hpp"
+#include "flow_field.hpp"
+#include "jps.hpp"
+
+// ---------- allocation tracking ----------
+// every operator new goes through here: count calls, and keep live/peak heap
+// bytes in a 16-byte header in front of the block
+static std::atomic<long long> g_allocs{0};
+static std::atomic<long long> g_live{0}, g_peak{0};
+
+static void *tracked_alloc(std::size_t n)
+{
+    void *p = std::malloc(n + 16);
+    if (!p) throw std::bad_alloc();
+    *(std::size_t*)p = n;
+    ++g_allocs;
+    long long live = g_live += (long long)n, peak = g_peak.load();
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live)) {}
+    return (char*)p + 16;
+}
+
+static void tracked_free(void *p)
+{
+    if (!p) return;
+    char *base = (char*)p - 16;
+    g_live -= (long long)*(std::size_t*)base;
+    std::free(base);
+}
+
+void *operator new(std::size_t n)                          { return tracked_alloc(n); }
+void *operator new[](std::size_t n)                        { return tracked_alloc(n); }
+void  operator delete(void *p) noexcept                    { tracked_free(p); }
+void  operator delete[](void *p) noexcept                  { tracked_free(p); }
+void  operator delete(void *p, std::size_t) noexcept       { tracked_free(p); }
+void  operator delete[](void *p, std::size_t) noexcept     { tracked_free(p); }
+
+static double peak_rss_mb()
+{
+#ifndef _WIN32
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss / 1024.0;          // Linux reports KiB
+#else
+    return 0.0;
+#endif
+}
+
+// ---------- chase scenario ----------
+// The player random-walks one cell per query (no turning back unless stuck);
+// the monster asks its engine for one step per query and takes it. A caught
+// player respawns the monster on the next cell of a fixed list. Every engine
+// sees the same maze, start cells, walk and respawn list.
+struct Scenario {
+    MazeGrid maze;
+    std::vector<std::vector<int>> nested;      // the same maze as vector<vector<int>>, for the baseline
+    std::vector<std::pair<int,int>> walk;      // player cell per query
+    std::vector<std::pair<int,int>> respawn;   // monster starts, [0] is the first
+    long long roads{0};
+};
+
+static const int BENCH_DR[4] = {-1, +1, 0, 0};
+static const int BENCH_DC[4] = { 0, 0, -1, +1};
+
+static void build_scenario(Scenario &sc, int size, float loop, uint32_t seed, int queries)
+{
+    MazeGenOptions gen;
+    gen.H = size; gen.W = size; gen.seed = seed; gen.loop_density = loop;
+    auto exit_cell = generate_single_exit_maze(sc.maze, gen);
+    const MazeGrid &g = sc.maze;
+    sc.nested.assign(g.H, std::vector<int>(g.W));
+    for (int r=0;r<g.H;++r) for (int c=0;c<g.W;++c) sc.nested[r][c] = g.at(r,c);
+
+    RoadIndex idx;
+    build_road_index(idx, g, g.index(exit_cell.first, exit_cell.second));
+    sc.roads = (long long)idx.cells.size() + 1;          // BFS reaches the exit too
+    std::mt19937 rng(seed);
+    auto cell = [&](int i){ return std::pair<int,int>{g.row_of(i), g.col_of(i)}; };
+
+    std::pair<int,int> p = cell(sample_road(idx, rng));
+    sc.respawn.clear();
+    for (int i=0; i<64 && roads_left(idx)>0; ++i) sc.respawn.push_back(cell(sample_road(idx, rng)));
+
+    sc.walk.assign(1, p);
+    int last=-1;
+    for (int q=1; q<queries; ++q){
+        int opts[4], n=0;
+        for (int k=0;k<4;++k)
+            if (walkable(g, p.first+BENCH_DR[k], p.second+BENCH_DC[k]) && (last<0 || k!=(last^1))) opts[n++]=k;
+        int k = n ? opts[std::uniform_int_distribution<int>(0,n-1)(rng)] : (last^1);
+        if (k>=0){ p={p.first+BENCH_DR[k], p.second+BENCH_DC[k]}; last=k; }
+        sc.walk.push_back(p);
+    }
+}
+
+// ---------- pre-series baseline ----------
+// astar_next_step as main.cpp had it before MazeGrid and AStarContext: a
+// vector<vector<int>> maze, and fresh H×W score and parent tables plus a
+// std::priority_queue allocated on every call. Only `expanded` is added, so
+// its nodes/query column is comparable.
+namespace bench_baseline {
+
+using std::pair;
+using std::vector;
+
+pair<int,int> astar_next_step(const vector<vector<int>>& g, pair<int,int> s, pair<int,int> t, long long &expanded)
+{
+    if (s==t) return s;
+    const int H = (int)g.size(), W = (int)g[0].size();
+    auto inb = [&](int r,int c){ return 0<=r && r<H && 0<=c && c<W; };
+    auto h   = [&](int r,int c){ return std::abs(r-t.first)+std::abs(c-t.second); };
+    static const int DR[4]={-1,1,0,0};
+    static const int DC[4]={0,0,-1,1};
+
+    struct Node{int r,c,g,f;};
+    struct Cmp{
+        bool operator()(const Node&a, const Node&b)const{
+            return (a.f>b.f) || (a.f==b.f && a.g>b.g);
+        }
+    };
+
+    std::vector<std::vector<int>> gscore(H, std::vector<int>(W, 1<<29));
+    std::vector<std::vector<pair<int,int>>> came(H, std::vector<pair<int,int>>(W, {-1,-1}));
+    std::priority_queue<Node, std::vector<Node>, Cmp> pq;
+
+    gscore[s.first][s.second]=0;
+    pq.push({s.first,s.second,0,h(s.first,s.second)});
+
+    while(!pq.empty()){
+        auto cur = pq.top(); pq.pop();
+        ++expanded;
+        if (cur.r==t.first && cur.c==t.second) break;
+        for(int k=0;k<4;++k){
+            int rr=cur.r+DR[k], cc=cur.c+DC[k];
+            if(!inb(rr,cc) || g[rr][cc]==WALL) continue;
+            int ng=cur.g+1;
+            if (ng<gscore[rr][cc]){
+                gscore[rr][cc]=ng;
+                came[rr][cc]={cur.r,cur.c};
+                int nf=ng+h(rr,cc);
+                pq.push({rr,cc,ng,nf});
+            }
+        }
+    }
+
+    auto target=t;
+    if (came[target.first][target.second].first==-1){ // unreachable
+        int bestf=1<<30; pair<int,int> best=s;
+        for(int r=0;r<H;++r) for(int c=0;c<W;++c){
+            if (gscore[r][c]<(1<<29)){
+                int f=gscore[r][c]+h(r,c);
+                if (f<bestf){bestf=f; best={r,c};}
+            }
+        }
+        target=best; if (target==s) return s;
+    }
+    // backtrack to s; take next step
+    pair<int,int> cur=target;
+    vector<pair<int,int>> path;
+    while(!(cur==s)){
+        path.push_back(cur);
+        auto p=came[cur.first][cur.second];
+        if (p.first==-1) break;
+        cur=p;
+    }
+    if (path.empty()) return s;
+    return path.back();
+}
+
+} // namespace bench_baseline
+
+enum BenchEngine { B_BASELINE, B_ASTAR, B_CACHED, B_DSTAR, B_FLOW, B_JPS, B_COUNT };
+static const char *ENGINE_NAME[B_COUNT] = {"astar_baseline", "astar", "astar_cached", "dstar_lite", "flow_field", "jps"};
+
+struct BenchResult {
+    int queries{0};
+    double ns_per_query{0};
+    double nodes_per_query{0};
+    double allocs_per_query{0};
+    double heap_peak_mb{0};      // high-water of heap above the maze itself
+    long long bad_steps{-1};     // --check: steps not one cell closer by BFS; -1 unchecked
+};
+
+// engines that must always step along a shortest path; the PathCache follower
+// keeps walking a stale path until the player drifts AI_REPLAN_DRIFT cells
+static bool exact_engine(BenchEngine e) { return e!=B_CACHED; }
+
+// run one engine over the scenario until `max_queries` or `budget` seconds.
+// With `check`, every step is compared (untimed) against a BFS field from the
+// player: it must lower the distance by exactly one.
+static BenchResult run_engine(BenchEngine e, const Scenario &sc, int max_queries, double budget, bool check)
+{
+    using clock = std::chrono::steady_clock;
+    const MazeGrid &g = sc.maze;
+    BenchResult res;
+    const long long heap0 = g_live.load();
+    g_peak.store(heap0);
+    const long long allocs0 = g_allocs.load();
+    {
+        AStarContext ctx;
+        PathCache pc;
+        DStarLite d;
+        FlowField f;
+        JpsContext jp;
+        FlowField ref;
+        long long bad = 0;
+        std::pair<int,int> m = sc.respawn.empty() ? sc.walk[0] : sc.respawn[0];
+        size_t next_respawn = 1;
+        long long nodes = 0, ns = 0;
+        int q = 0;
+        const auto t_end = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(budget));
+
+        for (; q<max_queries && q<(int)sc.walk.size(); ++q){
+            const std::pair<int,int> p = sc.walk[(size_t)q];
+            if (m==p && !sc.respawn.empty()) m = sc.respawn[next_respawn++ % sc.respawn.size()];
+
+            std::pair<int,int> step;
+            const int replans0 = pc.replans;
+            const auto t0 = clock::now();
+            switch (e){
+                case B_BASELINE: step = bench_baseline::astar_next_step(sc.nested, m, p, nodes); break;
+                case B_ASTAR:  step = astar_next_step(g, ctx, m, p); break;
+                case B_CACHED: step = cached_next_step(g, ctx, pc, m, p); break;
+                case B_DSTAR:  step = dstar_next_step(g, d, m, p); break;
+                case B_JPS:    step = jps_next_step(g, jp, m, p); break;
+                case B_FLOW:
+                default:
+                    if (f.goal != g.index(p.first, p.second)){ build_flow_field(f, g, p); nodes += sc.roads; }
+                    step = flow_next_step(f, g, m);
+                    break;
+            }
+            const auto t1 = clock::now();
+            ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+
+            if (e==B_ASTAR)                          nodes += ctx.expanded;
+            else if (e==B_CACHED && pc.replans!=replans0) nodes += ctx.expanded;
+            else if (e==B_DSTAR)                     nodes += d.expanded;
+            else if (e==B_JPS)                       nodes += jp.astar.expanded;
+            if (check && m!=p){
+                if (ref.goal != g.index(p.first, p.second)) build_flow_field(ref, g, p);
+                const int dm = ref.dist[g.index(m.first, m.second)];
+                if (dm>0 && (!walkable(g, step.first, step.second) || ref.dist[g.index(step.first, step.second)] != dm-1)) ++bad;
+            }
+            m = step;
+            if (t1 >= t_end && q >= 4) { ++q; break; }
+        }
+        res.queries = q;
+        if (q>0){
+            res.ns_per_query = (double)ns / q;
+            res.nodes_per_query = (double)nodes / q;
+            res.allocs_per_query = (double)(g_allocs.load() - allocs0) / q;
+        }
+        res.heap_peak_mb = (g_peak.load() - heap0) / (1024.0*1024.0);
+        if (check) res.bad_steps = bad;
+    }
+    return res;
+}
+
+// usage: ./path_bench [--sizes 25,64,...] [--loops 0,0.08,...] [--seed S]
+//                     [--queries N] [--budget SECONDS] [--csv] [--check]
+// --check also counts steps off a shortest path, over the chase and over a second
+// run with the player standing still (only the monster end moves), and exits 1
+// if an exact engine took one
+static std::vector<double> parse_list(const std::string &s)
+{
+    std::vector<double> out;
+    size_t i=0;
+    while (i<s.size()){
+        size_t j=s.find(',', i);
+        if (j==std::string::npos) j=s.size();
+        out.push_back(std::stod(s.substr(i, j-i)));
+        i=j+1;
+    }
+    return out;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<double> sizes = {25, 64, 256, 1024, 4096};
+    std::vector<double> loops = {0.0, 0.08, 0.3};
+    uint32_t seed = 12345;
+    int queries = 2000;
+    double budget = 1.0;
+    bool csv = false, check = false;
+    try{
+        for (int i=1;i<argc;++i){
+            std::string k=argv[i];
+            auto val = [&]() -> std::string {
+                if (i+1>=argc) throw std::runtime_error("missing value for " + k);
+                return argv[++i];
+            };
+            if      (k=="--sizes")   sizes = parse_list(val());
+            else if (k=="--loops")   loops = parse_list(val());
+            else if (k=="--seed")    seed = (uint32_t)std::stoul(val());
+            else if (k=="--queries") queries = std::stoi(val());
+            else if (k=="--budget")  budget = std::stod(val());
+            else if (k=="--csv")     csv = true;
+            else if (k=="--check")   check = true;
+            else throw std::runtime_error("unknown option: " + k);
+        }
+    }catch(const std::exception& e){
+        std::cerr<<e.what()<<"\n";
+        return 2;
+    }
+
+    if (csv) std::cout<<"size,loop,engine,queries,ns_per_query,nodes_per_query,allocs_per_query,heap_peak_mb,peak_rss_mb,bad_steps\n";
+    else std::cout<<std::left<<std::setw(6)<<"size"<<std::setw(6)<<"loop"<<std::setw(16)<<"engine"
+                  <<std::right<<std::setw(8)<<"queries"<<std::setw(14)<<"ns/query"<<std::setw(14)<<"nodes/query"
+                  <<std::setw(13)<<"allocs/query"<<std::setw(11)<<"heap MB"<<std::setw(10)<<"rss MB"
+                  <<(check ? "   bad steps" : "")<<"\n";
+
+    long long exact_bad = 0;
+    try{
+        for (double sd : sizes) for (double loop : loops){
+            Scenario sc, still;
+            build_scenario(sc, (int)sd, (float)loop, seed, queries);
+            if (check){
+                still = sc;
+                still.walk.assign(sc.walk.size(), sc.walk[0]);
+            }
+            for (int e=0; e<B_COUNT; ++e){
+                BenchResult r = run_engine((BenchEngine)e, sc, queries, budget, check);
+                if (check) r.bad_steps += run_engine((BenchEngine)e, still, queries, budget, true).bad_steps;
+                if (check && exact_engine((BenchEngine)e)) exact_bad += r.bad_steps;
+                const double rss = peak_rss_mb();
+                if (csv){
+                    std::cout<<(int)sd<<","<<loop<<","<<ENGINE_NAME[e]<<","<<r.queries<<","<<r.ns_per_query<<","
+                             <<r.nodes_per_query<<","<<r.allocs_per_query<<","<<r.heap_peak_mb<<","<<rss<<","<<r.bad_steps<<"\n";
+                } else {
+                    std::cout<<std::left<<std::setw(6)<<(int)sd<<std::setw(6)<<loop<<std::setw(16)<<ENGINE_NAME[e]
+                             <<std::right<<std::fixed<<std::setprecision(1)
+                             <<std::setw(8)<<r.queries<<std::setw(14)<<r.ns_per_query<<std::setw(14)<<r.nodes_per_query
+                             <<std::setprecision(3)<<std::setw(13)<<r.allocs_per_query
+                             <<std::setprecision(1)<<std::setw(11)<<r.heap_peak_mb<<std::setw(10)<<rss;
+                    if (check) std::cout<<std::setw(12)<<r.bad_steps;
+                    std::cout<<"\n";
+                    std::cout.unsetf(std::ios::fixed);
+                }
+                std::cout.flush();
+            }
+        }
+    }catch(const std::exception& e){
+        std::cerr<<"ERROR: "<<e.what()<<"\n";
+        return 1;
+    }
+    if (exact_bad){
+        std::cerr<<exact_bad<<" steps off a shortest path\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+// pathfinding.hpp — monster pathfinding on a MazeGrid
+#ifndef PATHFINDING_HPP
+#define PATHFINDING_HPP
+
+#include <cstdint>
+#include <cstdlib>   // for std::abs
+#include <vector>
+#include <utility>
+#include <algorithm> // for std::push_heap / std::pop_heap
+
+#include "maze_grid.hpp"
+
+// Search buffers kept alive between A* calls.
+// A cell's gscore/came entries are only valid while stamp[i]==epoch, so a
+// new search "clears" everything by bumping the epoch instead of refilling
+// H*W entries. The open list is a plain vector heap so it keeps its storage.
+struct AStarContext {
+    struct Node { int i, g, f; };
+
+    std::vector<uint32_t> stamp;
+    std::vector<int>      gscore;
+    std::vector<int>      came;
+    std::vector<Node>     open;
+    uint32_t  epoch{0};
+    long long expanded{0};   // nodes popped by the last search
+};
+
+// start a new search over grid g (reallocates only when the grid size changed)
+inline void begin_search(AStarContext &ctx, const MazeGrid &g)
+{
+    const size_t N = g.cells.size();
+    if (ctx.stamp.size() != N) {
+        ctx.stamp.assign(N, 0);
+        ctx.gscore.resize(N);
+        ctx.came.resize(N);
+        ctx.epoch = 0;
+    }
+    if (++ctx.epoch == 0) {          // wrapped: old stamps could alias
+        std::fill(ctx.stamp.begin(), ctx.stamp.end(), 0);
+        ctx.epoch = 1;
+    }
+    ctx.open.clear();
+    ctx.expanded = 0;
+}
+
+// run A* from cell index si towards ti; returns the cell to walk to:
+// ti when reachable, else the explored cell with the best f (si if none)
+inline int astar_search(const MazeGrid &g, AStarContext &ctx, int si, int ti)
+{
+    begin_search(ctx, g);
+    const int tr=g.row_of(ti), tc=g.col_of(ti);
+    auto h = [&](int i){ return std::abs(g.row_of(i)-tr)+std::abs(g.col_of(i)-tc); };
+    auto worse = [](const AStarContext::Node&a, const AStarContext::Node&b){
+        return (a.f>b.f) || (a.f==b.f && a.g>b.g);
+    };
+
+    ctx.stamp[si]=ctx.epoch; ctx.gscore[si]=0; ctx.came[si]=-1;
+    ctx.open.push_back({si,0,h(si)});
+    int bestf=ctx.open[0].f, best=si;   // fallback target if ti is unreachable
+
+    while(!ctx.open.empty()){
+        std::pop_heap(ctx.open.begin(), ctx.open.end(), worse);
+        auto cur = ctx.open.back(); ctx.open.pop_back();
+        if (cur.g > ctx.gscore[cur.i]) continue;   // stale entry
+        ++ctx.expanded;
+        if (cur.i==ti) return ti;
+        for(int k=0;k<4;++k){
+            int ni=cur.i+g.step[k];
+            if(g.cells[ni]==WALL) continue;   // border cells are WALL
+            int ng=cur.g+1;
+            if (ctx.stamp[ni]!=ctx.epoch || ng<ctx.gscore[ni]){
+                ctx.stamp[ni]=ctx.epoch;
+                ctx.gscore[ni]=ng;
+                ctx.came[ni]=cur.i;
+                int nf=ng+h(ni);
+                if (nf<bestf || (nf==bestf && ni<best)){ bestf=nf; best=ni; }
+                ctx.open.push_back({ni,ng,nf});
+                std::push_heap(ctx.open.begin(), ctx.open.end(), worse);
+            }
+        }
+    }
+    return best;
+}
+
+// A*: fill `path` with cell indices from the step after s up to the target
+// chosen by astar_search; path is left empty when no move is possible
+inline void astar_path(const MazeGrid& g, AStarContext &ctx,
+                       std::pair<int,int> s, std::pair<int,int> t, std::vector<int> &path)
+{
+    path.clear();
+    if (s==t) return;
+    const int si=g.index(s.first,s.second);
+    int cur=astar_search(g, ctx, si, g.index(t.first,t.second));
+    while(cur!=si && cur!=-1){
+        path.push_back(cur);
+        cur=ctx.came[cur];
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+// A*: return next step
+inline std::pair<int,int> astar_next_step(const MazeGrid& g, AStarContext &ctx,
+                                          std::pair<int,int> s, std::pair<int,int> t)
+{
+    if (s==t) return s;
+    const int si=g.index(s.first,s.second);
+    int cur=astar_search(g, ctx, si, g.index(t.first,t.second)), next=-1;
+    while(cur!=si && cur!=-1){
+        next=cur;
+        cur=ctx.came[cur];
+    }
+    if (next==-1) return s;
+    return {g.row_of(next), g.col_of(next)};
+}
+
+// A planned path that the monster follows one cell per move.
+// It is only re-planned when the path runs out, stops starting next to
+// the monster, or the goal has drifted more than max_drift cells from
+// the cell it was planned to. A goal that steps onto the remaining path
+// just cuts the path short.
+struct PathCache {
+    std::vector<int> path;   // cell indices, step after the start first
+    size_t next{0};          // path[next] is the next cell to enter
+    int goal{-1};            // goal cell index the path was planned for
+    int max_drift{3};        // cells (Manhattan) the goal may move before replanning
+    long long replans{0};
+};
+
+// forget the path, e.g. after the maze has been replaced
+inline void clear_path(PathCache &pc)
+{
+    pc.path.clear(); pc.next=0; pc.goal=-1;
+}
+
+// next step from s towards t, following the cached path when it is still usable
+inline std::pair<int,int> cached_next_step(const MazeGrid& g, AStarContext &ctx, PathCache &pc,
+                                           std::pair<int,int> s, std::pair<int,int> t)
+{
+    if (s==t) return s;
+    const int si=g.index(s.first,s.second), ti=g.index(t.first,t.second);
+
+    bool replan = pc.goal<0 || pc.next>=pc.path.size();
+    if (!replan){
+        int d=std::abs(pc.path[pc.next]-si);
+        if (d!=1 && d!=g.stride) replan=true;          // monster left the path
+    }
+    if (!replan && ti!=pc.goal){
+        auto rest=pc.path.begin()+pc.next;
+        auto hit=std::find(rest, pc.path.end(), ti);
+        if (hit!=pc.path.end()){                        // goal walked onto our path
+            pc.path.erase(hit+1, pc.path.end());
+            pc.goal=ti;
+        } else {
+            int drift=std::abs(g.row_of(ti)-g.row_of(pc.goal))+std::abs(g.col_of(ti)-g.col_of(pc.goal));
+            if (drift>pc.max_drift) replan=true;
+        }
+    }
+    if (replan){
+        astar_path(g, ctx, s, t, pc.path);
+        pc.next=0; pc.goal=ti; ++pc.replans;
+        if (pc.path.empty()) { pc.goal=-1; return s; }
+    }
+    int nxt=pc.path[pc.next++];
+    return {g.row_of(nxt), g.col_of(nxt)};
+}
+
+#endif // PATHFINDING_HPP
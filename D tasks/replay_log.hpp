@@ -0,0 +1,371 @@
+// replay_log.hpp — record rounds as compact input logs (.mzr) and replay them through sim_tick
+#ifndef REPLAY_LOG_HPP
+#define REPLAY_LOG_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "maze_grid.hpp"
+#include "maze_gen.hpp"
+#include "round_setup.hpp"
+#include "game_sim.hpp"
+
+// ---------- .mzr layout (varints are LEB128, floats raw little-endian) ----------
+// header  "MZR1", SimConfig (dt, speeds, pick radius, coin value, drift)
+// round   0x01, engine, maze, player cell, monster cells, coin cells, events, result
+//   maze      0 + H W seed loop_density exit_side  (regenerated on replay)
+//          or 1 + H W + run lengths of alternating WALL/ROAD cells, row-major
+//   cells     r*W+c; coins sorted and delta coded (slot order does not matter)
+//   events    one byte per run: low 3 bits code, high 5 bits run length
+//             (0 = varint length follows). Codes 0..4 = ticks with no input /
+//             up / down / left / right, REPLAY_TAB = engine switch, REPLAY_END
+//             closes the round
+//   result    outcome (0 unfinished, 1 win, 2 lose), ticks, score, coins
+// end     0x00 (a log cut short by a crash simply ends after its last round)
+//
+// Everything else in a round follows from sim_tick being a pure function of
+// the state and the per-tick input, so a run only breaks when the player
+// picks a new direction: a few bytes per second of play.
+
+static const uint8_t REPLAY_NONE = 0;     // codes 1..4 follow SIM_DR/SIM_DC order
+static const uint8_t REPLAY_TAB  = 5;
+static const uint8_t REPLAY_END  = 6;
+
+// direction of a SimInput as an event code, and back
+inline uint8_t replay_code(SimInput in)
+{
+    for (int k=0;k<4;++k) if (in.dr==SIM_DR[k] && in.dc==SIM_DC[k]) return (uint8_t)(k+1);
+    return REPLAY_NONE;
+}
+inline SimInput replay_input(uint8_t code)
+{
+    if (code<1 || code>4) return {};
+    return {SIM_DR[code-1], SIM_DC[code-1]};
+}
+
+namespace replay_detail {
+
+inline void put_varint(std::vector<uint8_t> &out, uint64_t v)
+{
+    while (v >= 0x80){ out.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((uint8_t)v);
+}
+
+inline void put_f32(std::vector<uint8_t> &out, float f)
+{
+    uint32_t u; std::memcpy(&u, &f, 4);
+    for (int i=0;i<4;++i) out.push_back((uint8_t)(u >> (8*i)));
+}
+
+// bounds-checked cursor over a whole log read into memory
+struct Cursor {
+    const uint8_t *p{nullptr}, *end{nullptr};
+
+    bool done() const { return p>=end; }
+    uint8_t byte()
+    {
+        if (p>=end) throw std::runtime_error("replay log is truncated");
+        return *p++;
+    }
+    uint64_t varint()
+    {
+        uint64_t v=0;
+        for (int shift=0; shift<64; shift+=7){
+            uint8_t b=byte();
+            v |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        throw std::runtime_error("bad varint in replay log");
+    }
+    float f32()
+    {
+        uint32_t u=0;
+        for (int i=0;i<4;++i) u |= (uint32_t)byte() << (8*i);
+        float f; std::memcpy(&f, &u, 4);
+        return f;
+    }
+};
+
+inline void put_cell(std::vector<uint8_t> &out, const MazeGrid &g, std::pair<int,int> rc)
+{
+    put_varint(out, (uint64_t)rc.first*g.W + rc.second);
+}
+
+inline std::pair<int,int> get_cell(Cursor &in, const MazeGrid &g)
+{
+    const uint64_t i = in.varint();
+    if (i >= (uint64_t)g.H*g.W) throw std::runtime_error("replay cell outside the maze");
+    return {(int)(i / g.W), (int)(i % g.W)};
+}
+
+} // namespace replay_detail
+
+// how a round ended, as stored after its events
+struct ReplayResult {
+    uint8_t outcome{0};       // 0 still running (window closed), 1 win, 2 lose
+    long ticks{0};
+    int  score{0}, coins{0};
+};
+
+inline ReplayResult replay_result(const GameState &s)
+{
+    ReplayResult r;
+    r.outcome = s.victory ? 1 : s.game_over ? 2 : 0;
+    r.ticks = s.ticks; r.score = s.score; r.coins = s.coins_collected;
+    return r;
+}
+
+inline bool operator==(const ReplayResult &a, const ReplayResult &b)
+{
+    return a.outcome==b.outcome && a.ticks==b.ticks && a.score==b.score && a.coins==b.coins;
+}
+
+// ---------- recording ----------
+// Bytes are buffered per round and written out when it ends, so a crash
+// loses at most the round in progress.
+struct ReplayWriter {
+    std::ofstream file;
+    std::vector<uint8_t> buf;
+    uint8_t  code{REPLAY_NONE};       // pending tick run
+    uint64_t run{0};
+    bool in_round{false};
+    uint64_t bytes{0}, ticks{0};      // totals written, for the bytes/s report
+};
+
+namespace replay_detail {
+
+inline void flush_run(ReplayWriter &w)
+{
+    if (w.run==0) return;
+    if (w.run < 32) w.buf.push_back((uint8_t)(w.code | (w.run << 3)));
+    else { w.buf.push_back(w.code); put_varint(w.buf, w.run); }
+    w.run = 0;
+}
+
+inline void flush_buf(ReplayWriter &w)
+{
+    w.file.write((const char*)w.buf.data(), (std::streamsize)w.buf.size());
+    w.file.flush();
+    w.bytes += w.buf.size();
+    w.buf.clear();
+}
+
+} // namespace replay_detail
+
+inline void open_replay(ReplayWriter &w, const std::string &path, const SimConfig &cfg)
+{
+    using namespace replay_detail;
+    w.file.open(path, std::ios::binary | std::ios::trunc);
+    if (!w.file) throw std::runtime_error("cannot write replay log: " + path);
+    w.buf.assign({'M','Z','R','1'});
+    put_f32(w.buf, cfg.dt);
+    put_f32(w.buf, cfg.player_speed);
+    put_f32(w.buf, cfg.monster_speed);
+    put_f32(w.buf, cfg.pick_radius);
+    put_varint(w.buf, (uint64_t)cfg.coin_value);
+    put_varint(w.buf, (uint64_t)cfg.replan_drift);
+    flush_buf(w);
+}
+
+// call with the layout before sim_start_round takes it over; the engine is
+// kept per round since TAB also works between rounds
+inline void replay_begin_round(ReplayWriter &w, const RoundLayout &L, AiEngine engine)
+{
+    using namespace replay_detail;
+    if (!w.file.is_open()) return;
+    const MazeGrid &g = L.maze;
+    w.buf.push_back(0x01);
+    w.buf.push_back((uint8_t)engine);
+    w.buf.push_back(L.generated ? 0 : 1);
+    put_varint(w.buf, (uint64_t)g.H);
+    put_varint(w.buf, (uint64_t)g.W);
+    if (L.generated){
+        put_varint(w.buf, L.gen.seed);
+        put_f32(w.buf, L.gen.loop_density);
+        w.buf.push_back((uint8_t)L.gen.exit_side);
+    } else {
+        int cur = WALL; uint64_t n = 0;                   // runs alternate, WALL first
+        for (int r=0;r<g.H;++r) for (int c=0;c<g.W;++c){
+            if (g.at(r,c)==cur){ ++n; continue; }
+            put_varint(w.buf, n); cur = g.at(r,c); n = 1;
+        }
+        put_varint(w.buf, n);
+    }
+
+    put_cell(w.buf, g, L.player);
+    put_varint(w.buf, L.monsters.size());
+    for (auto rc : L.monsters) put_cell(w.buf, g, rc);
+
+    std::vector<uint64_t> coins;
+    coins.reserve(L.coins.size());
+    for (auto rc : L.coins) coins.push_back((uint64_t)rc.first*g.W + rc.second);
+    std::sort(coins.begin(), coins.end());
+    put_varint(w.buf, coins.size());
+    uint64_t prev = 0;
+    for (uint64_t i : coins){ put_varint(w.buf, i - prev); prev = i; }
+
+    w.code = REPLAY_NONE; w.run = 0;
+    w.in_round = true;
+}
+
+// log the input of the sim_tick about to run on s. sim_tick only reads it
+// while the player stands on a cell, so on the other ticks the current run
+// just grows: a held key or a tween costs nothing extra.
+inline void replay_tick(ReplayWriter &w, const GameState &s, SimInput in)
+{
+    if (!w.in_round || round_over(s)) return;
+    const uint8_t code = replay_code(in);
+    if (code != w.code && !s.player.moving){ replay_detail::flush_run(w); w.code = code; }
+    ++w.run; ++w.ticks;
+}
+
+// sim_set_engine to the next engine, before the ticks that follow it
+inline void replay_engine_switch(ReplayWriter &w)
+{
+    if (!w.in_round) return;
+    replay_detail::flush_run(w);
+    w.buf.push_back(REPLAY_TAB | (1 << 3));
+}
+
+inline void replay_end_round(ReplayWriter &w, const GameState &s)
+{
+    using namespace replay_detail;
+    if (!w.in_round) return;
+    flush_run(w);
+    w.buf.push_back(REPLAY_END | (1 << 3));
+    const ReplayResult r = replay_result(s);
+    w.buf.push_back(r.outcome);
+    put_varint(w.buf, (uint64_t)r.ticks);
+    put_varint(w.buf, (uint64_t)r.score);
+    put_varint(w.buf, (uint64_t)r.coins);
+    w.in_round = false;
+    flush_buf(w);
+}
+
+// ends an open round as unfinished, then writes the end marker
+inline void close_replay(ReplayWriter &w, const GameState &s)
+{
+    if (!w.file.is_open()) return;
+    replay_end_round(w, s);
+    w.buf.push_back(0x00);
+    replay_detail::flush_buf(w);
+    w.file.close();
+}
+
+// ---------- replay ----------
+struct ReplayRound {
+    AiEngine engine{AI_DSTAR_LITE};
+    RoundLayout layout;
+    std::vector<std::pair<uint8_t,uint64_t>> events;   // (code, run length)
+    ReplayResult expected;
+    bool ended{false};                                  // false: the log stops mid-round
+};
+
+struct ReplayLog {
+    SimConfig cfg;
+    std::vector<ReplayRound> rounds;
+    size_t bytes{0};                 // log size on disk
+};
+
+inline ReplayLog read_replay(const std::string &path)
+{
+    using namespace replay_detail;
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw std::runtime_error("cannot open replay log: " + path);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (data.size()<4 || std::memcmp(data.data(), "MZR1", 4)!=0)
+        throw std::runtime_error("not a replay log: " + path);
+
+    Cursor in{data.data()+4, data.data()+data.size()};
+    ReplayLog log;
+    log.bytes = data.size();
+    log.cfg.dt            = in.f32();
+    log.cfg.player_speed  = in.f32();
+    log.cfg.monster_speed = in.f32();
+    log.cfg.pick_radius   = in.f32();
+    log.cfg.coin_value    = (int)in.varint();
+    log.cfg.replan_drift  = (int)in.varint();
+
+    while (!in.done()){
+        const uint8_t tag = in.byte();
+        if (tag==0x00) break;
+        if (tag!=0x01) throw std::runtime_error("bad round tag in replay log");
+        log.rounds.emplace_back();
+        ReplayRound &R = log.rounds.back();
+        RoundLayout &L = R.layout;
+        R.engine = (AiEngine)(in.byte() % AI_ENGINE_COUNT);
+
+        const uint8_t kind = in.byte();
+        const int H = (int)in.varint(), W = (int)in.varint();
+        if (kind==0){
+            L.generated = true;
+            L.gen.H = H; L.gen.W = W;
+            L.gen.seed = (uint32_t)in.varint();
+            L.gen.loop_density = in.f32();
+            L.gen.exit_side = (ExitSide)(in.byte() % 3);
+            generate_single_exit_maze(L.maze, L.gen);
+        } else {
+            init_grid(L.maze, H, W, WALL);
+            const uint64_t total = (uint64_t)H*W;
+            uint64_t at = 0; int cur = WALL;
+            while (at < total){
+                const uint64_t n = in.varint();
+                if (n > total-at) throw std::runtime_error("maze runs overflow in replay log");
+                for (uint64_t k=0;k<n;++k,++at) L.maze.set((int)(at / W), (int)(at % W), cur);
+                cur = cur==WALL ? ROAD : WALL;
+            }
+        }
+        L.exit_cell = find_single_exit(L.maze);
+
+        L.player = get_cell(in, L.maze);
+        L.monsters.resize((size_t)in.varint());
+        for (auto &rc : L.monsters) rc = get_cell(in, L.maze);
+        L.coins.resize((size_t)in.varint());
+        uint64_t prev = 0;
+        for (auto &rc : L.coins){
+            prev += in.varint();
+            if (prev >= (uint64_t)H*W) throw std::runtime_error("replay cell outside the maze");
+            rc = {(int)(prev / W), (int)(prev % W)};
+        }
+
+        // events up to the end marker; a cut-off log just stops here
+        while (!in.done()){
+            const uint8_t b = in.byte(), code = b & 7;
+            const uint64_t n = (b >> 3) ? (uint64_t)(b >> 3) : in.varint();
+            if (code==REPLAY_END){
+                R.ended = true;
+                R.expected.outcome = in.byte();
+                R.expected.ticks = (long)in.varint();
+                R.expected.score = (int)in.varint();
+                R.expected.coins = (int)in.varint();
+                break;
+            }
+            if (code>REPLAY_TAB) throw std::runtime_error("bad event in replay log");
+            R.events.push_back({code, n});
+        }
+    }
+    return log;
+}
+
+// play one recorded round into s; cfg follows its engine switches.
+// Returns what the round ended as, to compare with R.expected.
+inline ReplayResult replay_round(GameState &s, SimConfig &cfg, const ReplayRound &R)
+{
+    RoundLayout L = R.layout;            // the log stays replayable
+    cfg.engine = R.engine;
+    sim_start_round(s, cfg, std::move(L));
+    for (const auto &e : R.events){
+        if (e.first==REPLAY_TAB){ sim_set_engine(s, cfg, (AiEngine)((cfg.engine+1) % AI_ENGINE_COUNT)); continue; }
+        const SimInput in = replay_input(e.first);
+        for (uint64_t k=0;k<e.second;++k) sim_tick(s, cfg, in);
+    }
+    return replay_result(s);
+}
+
+#endif // REPLAY_LOG_HPP
@@ -0,0 +1,105 @@
+// round_setup.hpp — everything a round starts from, and a background producer for it
+#ifndef ROUND_SETUP_HPP
+#define ROUND_SETUP_HPP
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <utility>
+#include <future>
+#include <algorithm>
+#include <stdexcept>
+
+#include "maze_grid.hpp"
+#include "maze_gen.hpp"
+
+// Every ROAD cell index of a maze, built in one pass per maze. Samples are
+// drawn without replacement by a partial Fisher-Yates shuffle: cells[0..taken)
+// are the ones handed out so far, so no draw can repeat and none is retried.
+struct RoadIndex {
+    std::vector<int> cells;
+    size_t taken{0};
+};
+
+inline void build_road_index(RoadIndex &idx, const MazeGrid &g, int exclude = -1)
+{
+    idx.cells.clear(); idx.taken=0;
+    for (int r=0;r<g.H;++r){
+        int i=g.index(r,0);
+        for (int c=0;c<g.W;++c,++i)
+            if (g.cells[i]==ROAD && i!=exclude) idx.cells.push_back(i);
+    }
+}
+
+inline size_t roads_left(const RoadIndex &idx) { return idx.cells.size()-idx.taken; }
+
+// a ROAD cell index not handed out before; O(1)
+inline int sample_road(RoadIndex &idx, std::mt19937 &rng)
+{
+    if (roads_left(idx)==0) throw std::runtime_error("not enough ROAD cells");
+    size_t j=std::uniform_int_distribution<size_t>(idx.taken, idx.cells.size()-1)(rng);
+    std::swap(idx.cells[idx.taken], idx.cells[j]);
+    return idx.cells[idx.taken++];
+}
+
+// maze plus exit, spawn cells and coin cells for one round
+struct RoundLayout {
+    MazeGrid maze;
+    RoadIndex roads;                            // exit excluded; spawns and coins already taken
+    std::pair<int,int> exit_cell{-1,-1};
+    std::pair<int,int> player{-1,-1};
+    std::vector<std::pair<int,int>> monsters;   // avoid the player, the exit and each other
+    std::vector<std::pair<int,int>> coins;      // avoid every cell above; capped by free roads
+    MazeGenOptions gen;                         // how maze was made, when generated
+    bool generated{false};                      // false: loaded from a file
+};
+
+// pick spawn and coin cells on an already loaded/generated maze;
+// all of them are distinct draws from one road index
+inline void place_actors(RoundLayout &L, int num_monsters, int num_coins, std::mt19937 &rng)
+{
+    const MazeGrid &maze = L.maze;
+    L.exit_cell = find_single_exit(maze);
+    build_road_index(L.roads, maze, maze.index(L.exit_cell.first, L.exit_cell.second));
+    if (roads_left(L.roads) < (size_t)num_monsters+1)
+        throw std::runtime_error("not enough ROAD cells for the player and monsters");
+    auto cell = [&](int i){ return std::pair<int,int>{maze.row_of(i), maze.col_of(i)}; };
+
+    L.player = cell(sample_road(L.roads, rng));
+    L.monsters.clear();
+    for (int i=0;i<num_monsters;++i) L.monsters.push_back(cell(sample_road(L.roads, rng)));
+
+    const size_t n = std::min((size_t)std::max(num_coins, 0), roads_left(L.roads));
+    L.coins.clear(); L.coins.reserve(n);
+    for (size_t i=0;i<n;++i) L.coins.push_back(cell(sample_road(L.roads, rng)));
+}
+
+// generate a fresh maze and lay out a round on it; deterministic for gen.seed
+inline RoundLayout make_round(const MazeGenOptions &gen, int num_monsters, int num_coins)
+{
+    RoundLayout L;
+    generate_single_exit_maze(L.maze, gen);
+    L.gen = gen; L.generated = true;
+    std::mt19937 rng(gen.seed ^ 0x9e3779b9u);
+    place_actors(L, num_monsters, num_coins, rng);
+    return L;
+}
+
+// Single-slot producer: builds the next round on a worker thread while the
+// current one is played, so taking it is just a move.
+struct RoundPrefetcher {
+    std::future<RoundLayout> next;
+};
+
+inline void prefetch_round(RoundPrefetcher &pf, const MazeGenOptions &gen, int num_monsters, int num_coins)
+{
+    pf.next = std::async(std::launch::async, make_round, gen, num_monsters, num_coins);
+}
+
+// the prefetched round (waits only if the worker has not finished yet)
+inline RoundLayout take_round(RoundPrefetcher &pf)
+{
+    return pf.next.get();
+}
+
+#endif // ROUND_SETUP_HPP
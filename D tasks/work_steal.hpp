@@ -0,0 +1,84 @@
+// work_steal.hpp — parallel for over [0,n) with per-worker ranges and stealing
+#ifndef WORK_STEAL_HPP
+#define WORK_STEAL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+
+// Every worker starts with an equal slice of [0,n) and takes `grain` indices
+// at a time from the front of its own slice. A worker that runs dry steals
+// the back half of the largest remaining slice, so long rounds on one thread
+// cannot leave the others idle. Locks are per slice and touched once per grain.
+struct alignas(64) StealRange {
+    std::mutex m;
+    size_t lo{0}, hi{0};
+};
+
+namespace steal_detail {
+
+inline bool take_front(StealRange &r, size_t grain, size_t &b, size_t &e)
+{
+    std::lock_guard<std::mutex> lk(r.m);
+    if (r.lo>=r.hi) return false;
+    b=r.lo; e=std::min(r.hi, r.lo+grain); r.lo=e;
+    return true;
+}
+
+// move the back half of the fullest other slice into `self`
+inline bool steal(std::vector<StealRange> &rs, size_t self)
+{
+    size_t best=rs.size(), best_left=0;
+    for (size_t v=0; v<rs.size(); ++v){
+        if (v==self) continue;
+        std::lock_guard<std::mutex> lk(rs[v].m);
+        size_t left=rs[v].hi-rs[v].lo;
+        if (left>best_left){ best_left=left; best=v; }
+    }
+    if (best==rs.size()) return false;
+    size_t b, e;
+    {
+        std::lock_guard<std::mutex> lk(rs[best].m);
+        size_t left=rs[best].hi-rs[best].lo;
+        if (left==0) return true;                 // raced; look again
+        size_t half=(left+1)/2;
+        e=rs[best].hi; b=e-half; rs[best].hi=b;
+    }
+    std::lock_guard<std::mutex> lk(rs[self].m);
+    rs[self].lo=b; rs[self].hi=e;
+    return true;
+}
+
+} // namespace steal_detail
+
+// body(worker, i) for every i in [0,n); worker in [0,threads) is stable per
+// thread, so callers can keep per-worker state in a plain vector
+template <class Body>
+void parallel_for_stealing(size_t n, unsigned threads, size_t grain, Body body)
+{
+    threads = std::max(1u, threads);
+    grain = std::max<size_t>(1, grain);
+    std::vector<StealRange> rs(threads);
+    for (unsigned w=0; w<threads; ++w){
+        rs[w].lo = n*w/threads;
+        rs[w].hi = n*(w+1)/threads;
+    }
+
+    auto run = [&](unsigned w){
+        size_t b, e;
+        for (;;){
+            while (steal_detail::take_front(rs[w], grain, b, e))
+                for (size_t i=b;i<e;++i) body(w, i);
+            if (!steal_detail::steal(rs, w)) return;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned w=1; w<threads; ++w) pool.emplace_back(run, w);
+    run(0);
+    for (auto &t : pool) t.join();
+}
+
+#endif // WORK_STEAL_HPP
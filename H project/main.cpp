@@ -9,20 +9,18 @@
 #include <chrono>
 #include <algorithm>
 #include <set>
-#include <queue>     // for std::priority_queue
 #include <cstdlib>   // for std::system
-#include <cmath>     // for std::abs
 
 #include "splashkit.h"
 #include "nlohmann/json.hpp"
+#include "maze_grid.hpp"
+#include "pathfinding.hpp"
+#include "path_worker.hpp"
 
 using std::string;
 using std::vector;
 using std::pair;
 
-static const int WALL = 1;
-static const int ROAD = 0;
-
 // ---------- Tunables ----------
 static int   TILE         = 32;
 static int   PADDING      = 0;
@@ -50,7 +48,7 @@ inline drawing_options make_tile_scale(bitmap bmp)
 }
 
 // read maze: top-level 2D int array
-vector<vector<int>> load_maze(const string &path)
+MazeGrid load_maze(const string &path)
 {
     std::ifstream in(path);
     if (!in.is_open()) throw std::runtime_error("cannot open: " + path);
@@ -59,45 +57,18 @@ vector<vector<int>> load_maze(const string &path)
     if (!nj.is_array() || nj.empty() || !nj[0].is_array())
         throw std::runtime_error("maze.json must be a 2D array");
 
-    vector<vector<int>> g; g.reserve(nj.size());
-    for (auto &row : nj)
+    MazeGrid g;
+    init_grid(g, (int)nj.size(), (int)nj[0].size());
+    for (int r=0;r<g.H;++r)
     {
-        vector<int> r; r.reserve(row.size());
-        for (auto &x : row) r.push_back((int)x);
-        g.push_back(std::move(r));
+        const auto &row = nj[r];
+        if (!row.is_array() || (int)row.size()!=g.W)
+            throw std::runtime_error("maze.json rows must all have the same length");
+        for (int c=0;c<g.W;++c) g.set(r,c, (int)row[c]==ROAD ? ROAD : WALL);
     }
     return g;
 }
 
-// find the unique border exit (r,c)
-pair<int,int> find_single_exit(const vector<vector<int>>& g)
-{
-    int H=(int)g.size(), W=(int)g[0].size();
-    vector<pair<int,int>> exits;
-    for (int c=0;c<W;++c){
-        if (g[0][c]==ROAD)   exits.emplace_back(0,c);
-        if (g[H-1][c]==ROAD) exits.emplace_back(H-1,c);
-    }
-    for (int r=0;r<H;++r){
-        if (g[r][0]==ROAD)   exits.emplace_back(r,0);
-        if (g[r][W-1]==ROAD) exits.emplace_back(r,W-1);
-    }
-    if (exits.size()!=1) throw std::runtime_error("maze border must contain exactly one exit");
-    return exits[0];
-}
-
-// pick a random ROAD cell
-pair<int,int> random_road(const vector<vector<int>> &g, std::mt19937 &rng)
-{
-    int H=(int)g.size(), W=(int)g[0].size();
-    vector<pair<int,int>> roads; roads.reserve(H*W/2);
-    for (int r=0;r<H;++r) for (int c=0;c<W;++c)
-        if (g[r][c]==ROAD) roads.emplace_back(r,c);
-    if (roads.empty()) throw std::runtime_error("no ROAD cells");
-    std::uniform_int_distribution<> dist(0,(int)roads.size()-1);
-    return roads[dist(rng)];
-}
-
 // movement actor with tween
 struct Mover {
     int r{0}, c{0};       // current cell
@@ -140,77 +111,9 @@ void update_mover(Mover &m, float dt)
     }
 }
 
-// A*: return next step only
-pair<int,int> astar_next_step(const vector<vector<int>>& g, pair<int,int> s, pair<int,int> t)
-{
-    if (s==t) return s;
-    const int H = (int)g.size(), W = (int)g[0].size();
-    auto inb = [&](int r,int c){ return 0<=r && r<H && 0<=c && c<W; };
-    auto h   = [&](int r,int c){ return std::abs(r-t.first)+std::abs(c-t.second); };
-    static const int DR[4]={-1,1,0,0};
-    static const int DC[4]={0,0,-1,1};
-
-    struct Node{int r,c,g,f;};
-    struct Cmp{
-        bool operator()(const Node&a, const Node&b)const{
-            return (a.f>b.f) || (a.f==b.f && a.g>b.g);
-        }
-    };
-
-    std::vector<std::vector<int>> gscore(H, std::vector<int>(W, 1<<29));
-    std::vector<std::vector<pair<int,int>>> came(H, std::vector<pair<int,int>>(W, {-1,-1}));
-    std::priority_queue<Node, std::vector<Node>, Cmp> pq;
-
-    gscore[s.first][s.second]=0;
-    pq.push({s.first,s.second,0,h(s.first,s.second)});
-
-    while(!pq.empty()){
-        auto cur = pq.top(); pq.pop();
-        if (cur.r==t.first && cur.c==t.second) break;
-        for(int k=0;k<4;++k){
-            int rr=cur.r+DR[k], cc=cur.c+DC[k];
-            if(!inb(rr,cc) || g[rr][cc]==WALL) continue;
-            int ng=cur.g+1;
-            if (ng<gscore[rr][cc]){
-                gscore[rr][cc]=ng;
-                came[rr][cc]={cur.r,cur.c};
-                int nf=ng+h(rr,cc);
-                pq.push({rr,cc,ng,nf});
-            }
-        }
-    }
-
-    auto target=t;
-    if (came[target.first][target.second].first==-1){ // unreachable
-        int bestf=1<<30; pair<int,int> best=s;
-        for(int r=0;r<H;++r) for(int c=0;c<W;++c){
-            if (gscore[r][c]<(1<<29)){
-                int f=gscore[r][c]+h(r,c);
-                if (f<bestf){bestf=f; best={r,c};}
-            }
-        }
-        target=best; if (target==s) return s;
-    }
-    // backtrack to s; take next step
-    pair<int,int> cur=target;
-    vector<pair<int,int>> path;
-    while(!(cur==s)){
-        path.push_back(cur);
-        auto p=came[cur.first][cur.second];
-        if (p.first==-1) break;
-        cur=p;
-    }
-    if (path.empty()) return s;
-    return path.back();
-}
-
 // coin
 struct Coin { int r{0}, c{0}; bool collected{false}; };
 
-inline bool walkable(const vector<vector<int>>& g, int r, int c){
-    return 0<=r && r<(int)g.size() && 0<=c && c<(int)g[0].size() && g[r][c]==ROAD;
-}
-
 int main()
 {
     try{
@@ -228,7 +131,7 @@ int main()
             }
         // initial maze load (you can create one with: python generator.py generate)
         auto maze = load_maze("maze.json");
-        const int INIT_H=(int)maze.size(), INIT_W=(int)maze[0].size();
+        const int INIT_H=maze.H, INIT_W=maze.W;
 
         // window built for initial size; we keep H/W constant when regenerating
         const int SCR_W = INIT_W*TILE + PADDING*2;
@@ -286,6 +189,13 @@ int main()
 
         bool victory=false, game_over=false;
 
+        // monster pathfinding runs on its own thread; one request in flight
+        PathWorker ai;
+        start_path_worker(ai, 1);
+        path_worker_set_maze(ai, maze);
+        bool ai_pending = false;
+        pair<int,int> ai_start{-1,-1}, ai_goal{-1,-1};
+
         // regenerate maze of same size, then reset everything
         auto reset_round = [&](){
             int H = INIT_H, W = INIT_W;
@@ -308,6 +218,8 @@ int main()
             // reload
             maze = load_maze("maze.json");
             exit_cell = find_single_exit(maze);
+            path_worker_set_maze(ai, maze);
+            ai_pending = false;
 
             // respawn characters
             auto np = random_road(maze, rng);
@@ -348,13 +260,22 @@ int main()
                 }
             }
 
-            // monster AI
+            // monster AI: an idle monster asks the worker for its next step,
+            // and asks again (replacing the queued job) if the player has
+            // since changed cell; finished steps are picked up without waiting
             if (!monster.moving && !victory && !game_over){
-                auto step = astar_next_step(maze, {monster.r,monster.c}, {player.r,player.c});
-                if (step != pair<int,int>{monster.r,monster.c}) {
-                    start_move(monster, step.first, step.second);
+                pair<int,int> mcell{monster.r,monster.c}, pcell{player.r,player.c};
+                if (!ai_pending || ai_start != mcell || ai_goal != pcell){
+                    request_path(ai, 0, mcell, pcell);
+                    ai_pending = true; ai_start = mcell; ai_goal = pcell;
                 }
             }
+            drain_paths(ai, [&](const PathResult &res){
+                ai_pending = false;
+                if (monster.moving || victory || game_over) return;
+                if (res.start != pair<int,int>{monster.r,monster.c}) return;
+                if (res.step != res.start) start_move(monster, res.step.first, res.step.second);
+            });
 
             // tween updates
             if (!victory && !game_over){
@@ -402,12 +323,11 @@ int main()
             clear_screen(COLOR_BLACK);
 
             // map
-            int H=(int)maze.size(), W=(int)maze[0].size();
-            for (int r=0;r<H;++r) for(int c=0;c<W;++c){
+            for (int r=0;r<maze.H;++r) for(int c=0;c<maze.W;++c){
                 float x=cell_to_px_c(c), y=cell_to_px_r(r);
                 if (bitmap_valid(floor_bmp)) draw_bitmap(floor_bmp, x,y, opt_floor);
                 else fill_rectangle(COLOR_GRAY, x,y, TILE,TILE);
-                if (maze[r][c]==WALL){
+                if (maze.at(r,c)==WALL){
                     if (bitmap_valid(wall_bmp)) draw_bitmap(wall_bmp, x,y, opt_wall);
                     else fill_rectangle(COLOR_DARK_GREEN, x,y, TILE,TILE);
                 }
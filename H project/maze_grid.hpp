@@ -0,0 +1,84 @@
+// maze_grid.hpp — flat maze storage shared by loading, spawning and pathfinding
+#ifndef MAZE_GRID_HPP
+#define MAZE_GRID_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+static const int WALL = 1;
+static const int ROAD = 0;
+
+// One contiguous row-major buffer of 1-byte cells.
+// The logical H x W maze is wrapped in a one-cell WALL border, so every
+// in-maze cell has four addressable neighbours and walk checks need no
+// bounds test. Cell (r,c) lives at index (r+1)*stride + (c+1).
+struct MazeGrid {
+    int H{0}, W{0};             // logical size (border excluded)
+    int stride{0};              // W + 2
+    std::vector<uint8_t> cells; // (H+2) * stride, border = WALL
+    int step[4]{0,0,0,0};       // index offsets: up, down, left, right
+
+    int  index(int r, int c) const { return (r + 1) * stride + (c + 1); }
+    int  row_of(int i) const { return i / stride - 1; }
+    int  col_of(int i) const { return i % stride - 1; }
+    int  at(int r, int c) const { return cells[index(r, c)]; }
+    void set(int r, int c, int v) { cells[index(r, c)] = (uint8_t)v; }
+    bool empty() const { return H == 0 || W == 0; }
+};
+
+// size the buffer and fill it; the border is always WALL
+inline void init_grid(MazeGrid &g, int H, int W, int fill = WALL)
+{
+    if (H <= 0 || W <= 0) throw std::runtime_error("maze size must be positive");
+    g.H = H; g.W = W; g.stride = W + 2;
+    g.cells.assign((size_t)(H + 2) * g.stride, (uint8_t)WALL);
+    if (fill != WALL)
+        for (int r = 0; r < H; ++r)
+            std::fill_n(g.cells.begin() + g.index(r, 0), W, (uint8_t)fill);
+    g.step[0] = -g.stride; g.step[1] = g.stride;
+    g.step[2] = -1;        g.step[3] = 1;
+}
+
+// (r,c) may lie one cell outside the maze: the border answers WALL
+inline bool walkable(const MazeGrid &g, int r, int c)
+{
+    return g.cells[g.index(r, c)] == ROAD;
+}
+
+// find the unique border exit (r,c)
+inline std::pair<int,int> find_single_exit(const MazeGrid &g)
+{
+    const int H = g.H, W = g.W;
+    std::vector<std::pair<int,int>> exits;
+    for (int c=0;c<W;++c){
+        if (g.at(0,c)==ROAD)   exits.emplace_back(0,c);
+        if (g.at(H-1,c)==ROAD) exits.emplace_back(H-1,c);
+    }
+    for (int r=0;r<H;++r){
+        if (g.at(r,0)==ROAD)   exits.emplace_back(r,0);
+        if (g.at(r,W-1)==ROAD) exits.emplace_back(r,W-1);
+    }
+    if (exits.size()!=1) throw std::runtime_error("maze border must contain exactly one exit");
+    return exits[0];
+}
+
+// pick a random ROAD cell
+inline std::pair<int,int> random_road(const MazeGrid &g, std::mt19937 &rng)
+{
+    std::vector<int> roads; roads.reserve(g.cells.size()/2);
+    for (int r=0;r<g.H;++r){
+        int i = g.index(r,0);
+        for (int c=0;c<g.W;++c,++i)
+            if (g.cells[i]==ROAD) roads.push_back(i);
+    }
+    if (roads.empty()) throw std::runtime_error("no ROAD cells");
+    std::uniform_int_distribution<> dist(0,(int)roads.size()-1);
+    int i = roads[dist(rng)];
+    return {g.row_of(i), g.col_of(i)};
+}
+
+#endif // MAZE_GRID_HPP
@@ -0,0 +1,198 @@
+// path_worker.hpp — long-lived pathfinding thread for the monsters
+#ifndef PATH_WORKER_HPP
+#define PATH_WORKER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "maze_grid.hpp"
+#include "pathfinding.hpp"
+
+// One thread owns all monster pathfinding. The main loop posts (start, goal)
+// jobs with request_path and picks finished steps up with drain_paths once
+// a frame, so a search never blocks rendering.
+//
+// - Each monster has at most one queued job: a newer request replaces the
+//   queued one in place (merged), so a player who keeps moving costs one
+//   search per worker turn, not one per frame.
+// - Every request gets a sequence number; drain_paths drops results older
+//   than the monster's latest request, and results for an old maze.
+// - Results come back through a single-producer/single-consumer ring with
+//   no locks on either side.
+
+struct PathResult {
+    int monster{0};
+    std::pair<int,int> start{0,0}, goal{0,0};
+    std::pair<int,int> step{0,0};   // next cell from start (start if stuck)
+    uint32_t seq{0};                // request it answers
+    uint32_t maze_epoch{0};         // maze it was computed on
+};
+
+// Lock-free ring for one producer thread and one consumer thread.
+// CAP must be a power of two; head and tail only ever grow.
+template <typename T, size_t CAP>
+struct SpscQueue {
+    static_assert((CAP & (CAP-1)) == 0, "capacity must be a power of two");
+    T slots[CAP];
+    alignas(64) std::atomic<size_t> head{0};   // next slot to read (consumer)
+    alignas(64) std::atomic<size_t> tail{0};   // next slot to write (producer)
+};
+
+template <typename T, size_t CAP>
+inline bool spsc_push(SpscQueue<T,CAP> &q, const T &v)
+{
+    const size_t t = q.tail.load(std::memory_order_relaxed);
+    if (t - q.head.load(std::memory_order_acquire) == CAP) return false;   // full
+    q.slots[t & (CAP-1)] = v;
+    q.tail.store(t+1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, size_t CAP>
+inline bool spsc_pop(SpscQueue<T,CAP> &q, T &out)
+{
+    const size_t h = q.head.load(std::memory_order_relaxed);
+    if (h == q.tail.load(std::memory_order_acquire)) return false;         // empty
+    out = q.slots[h & (CAP-1)];
+    q.head.store(h+1, std::memory_order_release);
+    return true;
+}
+
+static const size_t PATH_RESULT_CAP = 256;
+
+struct PathJob {
+    std::pair<int,int> start{0,0}, goal{0,0};
+    uint32_t seq{0};
+    bool queued{false};
+};
+
+struct PathWorker {
+    // shared with the worker, guarded by m
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<PathJob> jobs;             // one slot per monster
+    std::deque<int> order;                 // monsters with a queued job, oldest first
+    std::shared_ptr<const MazeGrid> maze;
+    uint32_t maze_epoch{0};
+    bool stop{false};
+
+    SpscQueue<PathResult, PATH_RESULT_CAP> results;   // worker -> main loop
+
+    // main thread only
+    std::vector<uint32_t> latest;          // last seq requested per monster
+    uint32_t current_epoch{0};
+    long requests{0}, merged{0}, dropped{0};
+
+    std::thread thread;
+    ~PathWorker();
+};
+
+namespace path_worker_detail {
+
+inline void run(PathWorker &w)
+{
+    for (;;){
+        int id;
+        PathJob job;
+        std::shared_ptr<const MazeGrid> maze;
+        uint32_t epoch;
+        {
+            std::unique_lock<std::mutex> lk(w.m);
+            w.cv.wait(lk, [&]{ return w.stop || !w.order.empty(); });
+            if (w.stop) return;
+            id = w.order.front(); w.order.pop_front();
+            job = w.jobs[(size_t)id];
+            w.jobs[(size_t)id].queued = false;
+            maze = w.maze;          // keeps this maze alive while we search it
+            epoch = w.maze_epoch;
+        }
+        if (!maze) continue;
+
+        PathResult r;
+        r.monster = id; r.start = job.start; r.goal = job.goal;
+        r.seq = job.seq; r.maze_epoch = epoch;
+        r.step = astar_next_step(*maze, job.start, job.goal);
+
+        // the ring only fills if the main loop stops draining
+        while (!spsc_push(w.results, r)){
+            {
+                std::lock_guard<std::mutex> lk(w.m);
+                if (w.stop) return;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace path_worker_detail
+
+// start the thread; monster ids are 0 .. monsters-1
+inline void start_path_worker(PathWorker &w, int monsters)
+{
+    w.jobs.assign((size_t)monsters, PathJob{});
+    w.latest.assign((size_t)monsters, 0);
+    w.stop = false;
+    w.thread = std::thread(path_worker_detail::run, std::ref(w));
+}
+
+inline void stop_path_worker(PathWorker &w)
+{
+    {
+        std::lock_guard<std::mutex> lk(w.m);
+        w.stop = true;
+    }
+    w.cv.notify_all();
+    if (w.thread.joinable()) w.thread.join();
+}
+
+inline PathWorker::~PathWorker() { stop_path_worker(*this); }
+
+// hand the worker its own copy of the maze; queued jobs and any result
+// still in flight for the previous maze are discarded
+inline void path_worker_set_maze(PathWorker &w, const MazeGrid &g)
+{
+    auto copy = std::make_shared<const MazeGrid>(g);
+    std::lock_guard<std::mutex> lk(w.m);
+    w.maze = std::move(copy);
+    w.current_epoch = ++w.maze_epoch;
+    for (auto &j : w.jobs) j.queued = false;
+    w.order.clear();
+}
+
+// ask for monster `id`'s next step from start towards goal; replaces a job
+// for the same monster that the worker has not picked up yet
+inline void request_path(PathWorker &w, int id, std::pair<int,int> start, std::pair<int,int> goal)
+{
+    const uint32_t seq = ++w.latest[(size_t)id];
+    ++w.requests;
+    {
+        std::lock_guard<std::mutex> lk(w.m);
+        PathJob &j = w.jobs[(size_t)id];
+        if (j.queued) ++w.merged;
+        else w.order.push_back(id);
+        j.start = start; j.goal = goal; j.seq = seq; j.queued = true;
+    }
+    w.cv.notify_one();
+}
+
+// call f(result) for every finished job that answers the monster's latest
+// request on the current maze; older answers are dropped
+template <typename F>
+inline void drain_paths(PathWorker &w, F f)
+{
+    PathResult r;
+    while (spsc_pop(w.results, r)){
+        if (r.maze_epoch != w.current_epoch || r.seq != w.latest[(size_t)r.monster]){ ++w.dropped; continue; }
+        f(r);
+    }
+}
+
+#endif // PATH_WORKER_HPP
@@ -0,0 +1,73 @@
+// pathfinding.hpp — A* next step for the monster over a MazeGrid
+#ifndef PATHFINDING_HPP
+#define PATHFINDING_HPP
+
+#include <vector>
+#include <queue>     // for std::priority_queue
+#include <utility>
+#include <cstdlib>   // for std::abs
+
+#include "maze_grid.hpp"
+
+// A*: return next step only
+inline std::pair<int,int> astar_next_step(const MazeGrid& g, std::pair<int,int> s, std::pair<int,int> t)
+{
+    if (s==t) return s;
+    const int tr=t.first, tc=t.second;
+    auto h = [&](int i){ return std::abs(g.row_of(i)-tr)+std::abs(g.col_of(i)-tc); };
+
+    struct Node{int i,g,f;};
+    struct Cmp{
+        bool operator()(const Node&a, const Node&b)const{
+            return (a.f>b.f) || (a.f==b.f && a.g>b.g);
+        }
+    };
+
+    const int N = (int)g.cells.size();
+    std::vector<int> gscore(N, 1<<29);
+    std::vector<int> came(N, -1);
+    std::priority_queue<Node, std::vector<Node>, Cmp> pq;
+
+    const int si=g.index(s.first,s.second), ti=g.index(tr,tc);
+    gscore[si]=0;
+    pq.push({si,0,h(si)});
+
+    while(!pq.empty()){
+        auto cur = pq.top(); pq.pop();
+        if (cur.i==ti) break;
+        for(int k=0;k<4;++k){
+            int ni=cur.i+g.step[k];
+            if(g.cells[ni]==WALL) continue;   // border cells are WALL
+            int ng=cur.g+1;
+            if (ng<gscore[ni]){
+                gscore[ni]=ng;
+                came[ni]=cur.i;
+                pq.push({ni,ng,ng+h(ni)});
+            }
+        }
+    }
+
+    int target=ti;
+    if (came[target]==-1){ // unreachable
+        int bestf=1<<30, best=si;
+        for(int i=0;i<N;++i){
+            if (gscore[i]<(1<<29)){
+                int f=gscore[i]+h(i);
+                if (f<bestf){bestf=f; best=i;}
+            }
+        }
+        target=best; if (target==si) return s;
+    }
+    // backtrack to s; take next step
+    int cur=target, next=-1;
+    while(cur!=si){
+        next=cur;
+        int p=came[cur];
+        if (p==-1) break;
+        cur=p;
+    }
+    if (next==-1) return s;
+    return {g.row_of(next), g.col_of(next)};
+}
+
+#endif // PATHFINDING_HPP
@@ -1,4 +1,5 @@
 #include "splashkit.h"
+#include "frame_pacing.h"
 
 /**
  * Structure to encapsulate game-related data, including window properties,
@@ -14,50 +15,62 @@ typedef struct game_data {
 /**
  * Displays a detailed screen with a small orange-red circle at the specified coordinates.
  * Exits this screen and returns to the main flow when the SPACE key is pressed.
+ * The screen is drawn once and the loop then sleeps until a key arrives.
  * 
- * @param x The x-coordinate for the center of the small orange-red circle.
- * @param y The y-coordinate for the center of the small orange-red circle.
+ * @param x     The x-coordinate for the center of the small orange-red circle.
+ * @param y     The y-coordinate for the center of the small orange-red circle.
+ * @param pacer Redraw and event-wait state shared with the main loop.
  * @return Always returns `1` to signal successful completion (used for control flow).
  */
-int details(float x, float y) {
-    while (true) {
-        clear_screen(color_light_blue());
-        fill_circle(color_orange_red(), x, y, 2);
-        refresh_screen();
+int details(float x, float y, frame_pacer &pacer) {
+    pacer.dirty = true;
+    while (!quit_requested()) {
+        if (pacer.dirty) {
+            clear_screen(color_light_blue());
+            fill_circle(color_orange_red(), x, y, 2);
+            present_frame(pacer);
+        }
+        wait_for_events(pacer);
         if (key_typed(SPACE_KEY)) {
-            return 1;
-        } else {
-            continue;
+            break;
         }
     }
+    pacer.dirty = true; // The caller's screen has to come back
+    return 1;
 }
 
 /**
  * Manages the game's menu screen (displayed with a light green background).
  * - Pressing SPACE exits the menu and returns to the main game (`return 1`).
- * - Pressing 'Q' quits the program entirely (`return 0`).
+ * - Pressing 'Q' (or closing the window) quits the program entirely (`return 0`).
  * 
+ * @param pacer Redraw and event-wait state shared with the main loop.
  * @return `1` to exit the menu and resume the game; `0` to quit the program.
  */
-int menu() {
-    while (true) {
-        clear_screen(color_light_green());
-        refresh_screen();
+int menu(frame_pacer &pacer) {
+    pacer.dirty = true;
+    while (!quit_requested()) {
+        if (pacer.dirty) {
+            clear_screen(color_light_green());
+            present_frame(pacer);
+        }
+        wait_for_events(pacer);
         if (key_typed(SPACE_KEY)) {
+            pacer.dirty = true;
             return 1;
         } else if (key_typed(Q_KEY)) {
             return 0;
-        } else {
-            continue;
         }
     }
+    return 0;
 }
 
 /**
  * Main game function: initializes game data, opens a window, and runs the main game loop.
  * The loop handles:
- * - Rendering a random red circle.
+ * - Rendering a random red circle, only when it moves or another screen was shown.
  * - Responding to key presses (SPACE to reposition the circle, KEYPAD_1 for the "details" screen, KEYPAD_2 for the menu).
+ * - Sleeping in wait_for_events while no key arrives.
  * 
  * @return `0` to indicate successful program termination.
  */
@@ -70,30 +83,33 @@ int main() {
     game.menu_active = 1; // Start with the menu/logic active
 
     open_window("game", game.window_width, game.window_height);
-    clear_screen(color_white());
+    frame_pacer pacer; // Redraw only on change, sleep in between
 
-    float x, y; // Coordinates for the center of the red interactive circle
+    // Coordinates for the center of the red interactive circle
+    float x = rnd(game.window_width);
+    float y = rnd(game.window_height);
 
-    while (game.menu_active) {
-        process_events();
-        // Generate random coordinates for the red circle within the window
-        x = rnd(game.window_width);
-        y = rnd(game.window_height);
-        fill_circle(color_red(), x, y, game.circle_radius);
+    while (game.menu_active && !quit_requested()) {
+        if (pacer.dirty) {
+            clear_screen(color_white());
+            fill_circle(color_red(), x, y, game.circle_radius);
+            present_frame(pacer);
+        }
+
+        wait_for_events(pacer);
 
         if (key_typed(SPACE_KEY)) {
-            clear_screen(color_white());
+            // Generate new random coordinates for the red circle within the window
             x = rnd(game.window_width);
             y = rnd(game.window_height);
-            fill_circle(color_red(), x, y, game.circle_radius);
-            refresh_screen();
+            note_input(pacer); // Time this key press until the moved circle is shown
         } else if (key_typed(KEYPAD_1)) {
-            int unused_return = details(x, y); // Call "details" screen (return value unused)
+            details(x, y, pacer); // Call "details" screen (return value unused)
         } else if (key_typed(KEYPAD_2)) {
-            game.menu_active = menu(); // Update menu state based on menu screen's return
+            game.menu_active = menu(pacer); // Update menu state based on menu screen's return
         }
-        delay(100); // Small delay to control loop speed
     }
 
+    report_latency(pacer); // Frames drawn and key-to-photon latency
     return 0;
-}
\ No newline at end of file
+}
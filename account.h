@@ -0,0 +1,50 @@
+#ifndef ACCOUNT_H
+#define ACCOUNT_H
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+
+// Abstract base class (Abstraction)
+class Account {
+protected:
+    std::string name;     // Encapsulation: protected attribute
+    double balance;
+public:
+    Account(std::string n, double b=0) : name(n), balance(b) {}
+    virtual ~Account() {}
+
+    void deposit(double amount) { balance += amount; }
+    double get_balance() const { return balance; }
+
+    virtual void withdraw(double amount) = 0; // Pure virtual function (Abstraction)
+    virtual void print_info() const {
+        std::cout << "Account: " << name << ", Balance: " << balance << std::endl;
+    }
+};
+
+// Normal account (Inheritance)
+class NormalAccount : public Account {
+public:
+    NormalAccount(std::string n, double b=0) : Account(n,b) {}
+    void withdraw(double amount) override {   // Polymorphism
+        if(amount <= balance) balance -= amount;
+        else printf("Insufficient funds\n");
+    }
+};
+
+// Savings account (Inheritance + Polymorphism)
+class SavingsAccount : public Account {
+private:
+    double interest;
+public:
+    SavingsAccount(std::string n, double b=0, double i=0.02) 
+        : Account(n,b), interest(i) {}
+    void withdraw(double amount) override {
+        if(amount <= balance) balance -= amount;
+        else printf("Cannot overdraft a savings account\n");
+    }
+    void add_interest() { balance += balance * interest; }
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "splashkit.h"
+#include "frame_pacing.h"
 
 /**
  * Prompts the user to enter a target score and validates the input.
@@ -113,16 +114,27 @@ int main()
     float target_x, target_y;                // Coordinates for target's center
     generate_new_target(target_x, target_y, radius, win_width, win_height);
 
+    // Redraws happen only when the screen changed; between them the loop
+    // sleeps in wait_for_events until the user does something
+    frame_pacer pacer;
+
     // Main game loop - continues until user requests to quit
     while (!quit_requested())
     {
-        process_events();                    // Handle user input (mouse/keyboard events)
-        clear_screen(COLOR_WHITE);           // Clear screen with white background
+        if (pacer.dirty)
+        {
+            clear_screen(COLOR_WHITE);           // Clear screen with white background
+
+            // Draw game UI elements
+            draw_health_bar(remaining, target);  // Render progress bar
+            draw_text("Targets left: " + std::to_string(remaining), COLOR_BLACK, 300, 20);  // Display remaining count
+            draw_target(target_x, target_y, radius);  // Render current target
 
-        // Draw game UI elements
-        draw_health_bar(remaining, target);  // Render progress bar
-        draw_text("Targets left: " + std::to_string(remaining), COLOR_BLACK, 300, 20);  // Display remaining count
-        draw_target(target_x, target_y, radius);  // Render current target
+            present_frame(pacer);                // Update display with all drawn elements
+        }
+
+        // Nothing moves on its own, so there is no deadline: block until input
+        wait_for_events(pacer);
 
         // Check for left mouse button clicks
         if (mouse_clicked(LEFT_BUTTON))
@@ -131,13 +143,14 @@ int main()
             if (is_target_hit(mouse_x(), mouse_y(), target_x, target_y, radius))
             {
                 remaining--;  // Decrement remaining targets counter
+                note_input(pacer);  // Health bar, counter and target change: redraw and time it
 
                 // Check win condition (no remaining targets)
                 if (remaining <= 0)
                 {
                     clear_screen(COLOR_WHITE);  // Clear screen for victory message
                     draw_text("You win this game!!!", COLOR_RED, 300, 200);  // Display victory text
-                    refresh_screen();           // Update display to show message
+                    present_frame(pacer);       // Update display to show message
                     delay(3000);                // Pause for 3 seconds to let user see message
                     break;                      // Exit game loop (end game)
                 }
@@ -146,9 +159,8 @@ int main()
                 generate_new_target(target_x, target_y, radius, win_width, win_height);
             }
         }
-
-        refresh_screen();  // Update display with all drawn elements
     }
 
+    report_latency(pacer);  // Frames drawn and click-to-photon latency
     return 0;  // Indicate successful program termination
 }
@@ -0,0 +1,170 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include "splashkit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * Redraw-on-demand support for the small SplashKit games.
+ *
+ * Instead of clearing and presenting every frame, a game sets `dirty` when
+ * something visible changes (input, a target moving, a timer firing) and
+ * only then draws and calls present_frame. Between frames wait_for_events
+ * keeps polling SplashKit in short sleeps until input arrives or the next
+ * timed event is due, so an idle game costs almost no CPU.
+ *
+ * Click-to-photon latency: SplashKit does not timestamp events, so a click
+ * is known to have happened between the previous poll and the poll that
+ * reported it. present_frame records both ends, from that poll (the part
+ * the game controls) and from the poll before it (the worst case, which
+ * includes up to one sleep slice), until refresh_screen returns.
+ */
+typedef std::chrono::steady_clock pacing_clock;
+
+struct frame_pacer
+{
+    bool dirty = true;              /**< Something on screen changed since the last present. */
+    int slice_ms = 4;               /**< Longest sleep between two polls. */
+
+    pacing_clock::time_point start = pacing_clock::now();
+    pacing_clock::time_point last_poll = start;
+    pacing_clock::time_point prev_poll = start;
+
+    bool click_pending = false;     /**< Input waits for the frame that shows its effect. */
+    pacing_clock::time_point click_seen, click_earliest;
+
+    std::vector<double> latency_ms;     /**< Poll that saw the click -> present. */
+    std::vector<double> latency_max_ms; /**< Previous poll -> present. */
+    long frames = 0, polls = 0;
+};
+
+/**
+ * Milliseconds since the pacer was created.
+ *
+ * @param fp the pacer
+ * @returns elapsed time in ms
+ */
+inline double pacer_now_ms(const frame_pacer &fp)
+{
+    return std::chrono::duration<double, std::milli>(pacing_clock::now() - fp.start).count();
+}
+
+/**
+ * A clock reading (such as last_poll) in pacer milliseconds.
+ *
+ * @param fp the pacer
+ * @param t  the time point
+ * @returns ms since the pacer was created
+ */
+inline double pacer_ms(const frame_pacer &fp, pacing_clock::time_point t)
+{
+    return std::chrono::duration<double, std::milli>(t - fp.start).count();
+}
+
+/**
+ * True when the last process_events reported something a game reacts to.
+ */
+inline bool input_arrived()
+{
+    return quit_requested() || mouse_clicked(LEFT_BUTTON) || any_key_pressed();
+}
+
+/**
+ * Polls events until input arrives or `until_ms` (pacer time) is reached,
+ * sleeping at most slice_ms between polls. Always polls at least once, so
+ * key_typed and mouse_clicked are fresh when it returns. Pass a negative
+ * deadline to wait for input only.
+ *
+ * @param fp       the pacer
+ * @param until_ms pacer time of the next timed event, or -1 for none
+ * @returns true if input arrived, false on timeout
+ */
+inline bool wait_for_events(frame_pacer &fp, double until_ms = -1)
+{
+    while (true)
+    {
+        fp.prev_poll = fp.last_poll;
+        process_events();
+        fp.last_poll = pacing_clock::now();
+        fp.polls++;
+        if (input_arrived()) return true;
+
+        double now = pacer_now_ms(fp);
+        if (until_ms >= 0 && now >= until_ms) return false;
+        double sleep = fp.slice_ms;
+        if (until_ms >= 0) sleep = std::min(sleep, until_ms - now);
+        delay(std::max(1, (int)std::ceil(sleep)));   // never spin, even just before the deadline
+    }
+}
+
+/**
+ * Marks the input seen by the last poll (a click, or a key press) as the
+ * start of a latency sample and the screen as dirty; call it when handling
+ * input that changes what is shown.
+ *
+ * @param fp the pacer
+ */
+inline void note_input(frame_pacer &fp)
+{
+    fp.click_pending = true;
+    fp.click_seen = fp.last_poll;
+    fp.click_earliest = fp.prev_poll;
+    fp.dirty = true;
+}
+
+/**
+ * Presents the frame drawn since the last one and closes any open latency
+ * sample. Clears the dirty flag.
+ *
+ * @param fp the pacer
+ */
+inline void present_frame(frame_pacer &fp)
+{
+    refresh_screen();
+    pacing_clock::time_point shown = pacing_clock::now();
+    fp.frames++;
+    fp.dirty = false;
+    if (fp.click_pending)
+    {
+        fp.latency_ms.push_back(std::chrono::duration<double, std::milli>(shown - fp.click_seen).count());
+        fp.latency_max_ms.push_back(std::chrono::duration<double, std::milli>(shown - fp.click_earliest).count());
+        fp.click_pending = false;
+    }
+}
+
+/**
+ * Percentile of a set of samples, p in [0,1]; 0 when there are none.
+ */
+inline double pacing_percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0;
+    size_t k = (size_t)(p * (v.size() - 1) + 0.5);
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+/**
+ * Writes the frame count and the click-to-photon latency percentiles to the
+ * console.
+ *
+ * @param fp the pacer
+ */
+inline void report_latency(const frame_pacer &fp)
+{
+    double seconds = pacer_now_ms(fp) / 1000.0;
+    write_line("Frames drawn: " + std::to_string(fp.frames) + " in " + std::to_string(seconds) + " s ("
+               + std::to_string(fp.polls) + " event polls)");
+    if (fp.latency_ms.empty()) return;
+    write_line("Click-to-photon latency over " + std::to_string(fp.latency_ms.size()) + " inputs (ms): p50 "
+               + std::to_string(pacing_percentile(fp.latency_ms, 0.5)) + " to "
+               + std::to_string(pacing_percentile(fp.latency_max_ms, 0.5)) + ", p99 "
+               + std::to_string(pacing_percentile(fp.latency_ms, 0.99)) + " to "
+               + std::to_string(pacing_percentile(fp.latency_max_ms, 0.99)));
+}
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef GRID_VIEW_H
+#define GRID_VIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Extent value meaning "given at run time" in a GridView's extent list
+ */
+const size_t DYNAMIC_EXTENT = 0;
+
+/**
+ * How a GridView maps coordinates to storage
+ *
+ * ROW_MAJOR    - last coordinate varies fastest (C arrays)
+ * COLUMN_MAJOR - first coordinate varies fastest
+ * TILED_Z      - GRID_TILE^N tiles stored row-major, Z-order (Morton)
+ *                inside each tile, so neighbours in any direction share
+ *                cache lines
+ */
+enum GridLayout
+{
+    ROW_MAJOR,
+    COLUMN_MAJOR,
+    TILED_Z
+};
+
+/**
+ * Log2 of the tile side used by TILED_Z (8x8 tiles in 2D)
+ */
+const int GRID_TILE_BITS = 3;
+const size_t GRID_TILE = size_t(1) << GRID_TILE_BITS;
+
+/**
+ * A view of a flat buffer as an N-dimensional grid, N = number of extents.
+ * Extents that are not DYNAMIC_EXTENT are compile-time constants; when all
+ * are, the strides and storage size are constants too. Otherwise they are
+ * computed once when the view is made, never per access.
+ *
+ * The view does not own its data: the buffer must hold storage_size() items.
+ *
+ * GridView<int, ROW_MAJOR, 2, 3, 4>          fixed 2x3x4
+ * GridView<uint8_t, ROW_MAJOR, DYNAMIC_EXTENT,
+ *          DYNAMIC_EXTENT>                    H x W given at run time
+ */
+template <typename T, GridLayout Layout, size_t... Extents>
+struct GridView
+{
+    static constexpr int N = (int) sizeof...(Extents);
+    static_assert(N > 0, "a grid needs at least one dimension");
+    static_assert(Layout != TILED_Z || N * GRID_TILE_BITS < 32, "tile too big for its Morton index");
+
+    static constexpr size_t static_extent[N] = {Extents...};
+    static constexpr bool all_static = ((Extents != DYNAMIC_EXTENT) && ...);
+
+    T *data;
+    size_t extent[N];     // logical size per dimension
+    size_t stride[N];     // element stride (ROW/COLUMN_MAJOR) or tile stride (TILED_Z)
+    size_t storage;       // items the buffer must hold
+
+    /**
+     * Size of dimension d, constant when known at compile time
+     */
+    constexpr size_t size(int d) const
+    {
+        return static_extent[d] != DYNAMIC_EXTENT ? static_extent[d] : extent[d];
+    }
+
+    /**
+     * Items in the backing buffer (tiled layouts pad up to whole tiles)
+     */
+    constexpr size_t storage_size() const
+    {
+        if constexpr (all_static) return static_stride(Layout == COLUMN_MAJOR ? N - 1 : 0) *
+                                         static_span(Layout == COLUMN_MAJOR ? N - 1 : 0) *
+                                         (Layout == TILED_Z ? tile_items() : 1);
+        else return storage;
+    }
+
+    /**
+     * Storage index of a coordinate, no bounds checking
+     */
+    template <typename... I>
+    size_t index(I... coords) const
+    {
+        static_assert((int) sizeof...(I) == N, "one coordinate per dimension");
+        const size_t c[N] = {(size_t) coords...};
+        return index_of(c);
+    }
+
+    size_t index_of(const size_t (&c)[N]) const
+    {
+        size_t idx = 0;
+        if constexpr (Layout == TILED_Z)
+        {
+            // tile number row-major, then the low bits of every
+            // coordinate interleaved (bit b of dim d -> bit b*N + (N-1-d))
+            size_t morton = 0;
+            for (int d = 0; d < N; ++d)
+            {
+                idx += (c[d] >> GRID_TILE_BITS) * stride_of(d);
+                const size_t low = c[d] & (GRID_TILE - 1);
+                for (int b = 0; b < GRID_TILE_BITS; ++b)
+                    morton |= ((low >> b) & 1) << (b * N + (N - 1 - d));
+            }
+            return idx * tile_items() + morton;
+        }
+        else
+        {
+            for (int d = 0; d < N; ++d) idx += c[d] * stride_of(d);
+            return idx;
+        }
+    }
+
+    static constexpr size_t tile_items()
+    {
+        return size_t(1) << (GRID_TILE_BITS * N);
+    }
+
+    // Extent of dimension d in stride units (whole tiles for TILED_Z)
+    static constexpr size_t static_span(int d)
+    {
+        return Layout == TILED_Z ? (static_extent[d] + GRID_TILE - 1) / GRID_TILE : static_extent[d];
+    }
+
+    // Compile-time stride when every extent is static
+    static constexpr size_t static_stride(int d)
+    {
+        size_t s = 1;
+        if (Layout == COLUMN_MAJOR)
+            for (int k = 0; k < d; ++k) s *= static_span(k);
+        else
+            for (int k = d + 1; k < N; ++k) s *= static_span(k);
+        return s;
+    }
+
+    size_t stride_of(int d) const
+    {
+        if constexpr (all_static) return static_stride(d);
+        else return stride[d];
+    }
+
+    /**
+     * True if every coordinate is inside the grid
+     */
+    template <typename... I>
+    bool in_bounds(I... coords) const
+    {
+        static_assert((int) sizeof...(I) == N, "one coordinate per dimension");
+        const long long c[N] = {(long long) coords...};
+        for (int d = 0; d < N; ++d)
+            if (c[d] < 0 || (size_t) c[d] >= size(d)) return false;
+        return true;
+    }
+
+    /**
+     * Unchecked access
+     */
+    template <typename... I>
+    T &operator()(I... coords) const
+    {
+        return data[index(coords...)];
+    }
+
+    /**
+     * Checked access: throws std::out_of_range outside the grid
+     */
+    template <typename... I>
+    T &at(I... coords) const
+    {
+        if (!in_bounds(coords...)) throw std::out_of_range("grid coordinate out of range");
+        return data[index(coords...)];
+    }
+
+    /**
+     * Contiguous pass over the whole buffer in storage order, for loops
+     * that do not need coordinates (fill, sum, copy, dump)
+     */
+    T *begin() const { return data; }
+    T *end() const { return data + storage_size(); }
+
+    /**
+     * Call f(value, coords) for every cell. Row- and column-major views
+     * walk storage in order and only ever add to the running index;
+     * tiled views walk coordinates row-major.
+     */
+    template <typename F>
+    void for_each(F f) const
+    {
+        size_t c[N] = {};
+        for (int d = 0; d < N; ++d)
+            if (size(d) == 0) return;
+
+        // first = the dimension that varies fastest in storage
+        const int first = (Layout == COLUMN_MAJOR) ? 0 : N - 1;
+        const int dir = (Layout == COLUMN_MAJOR) ? 1 : -1;
+        const size_t inner = size(first);
+        size_t idx = 0;
+        for (;;)
+        {
+            if constexpr (Layout == TILED_Z)
+            {
+                for (c[first] = 0; c[first] < inner; ++c[first]) f(data[index_of(c)], c);
+            }
+            else
+            {
+                for (c[first] = 0; c[first] < inner; ++c[first]) f(data[idx++], c);
+            }
+            c[first] = 0;
+
+            // odometer over the remaining dimensions
+            int d = first + dir;
+            for (; d >= 0 && d < N; d += dir)
+            {
+                if (++c[d] < size(d)) break;
+                c[d] = 0;
+            }
+            if (d < 0 || d >= N) return;
+        }
+    }
+};
+
+/**
+ * Fill in a view's extents, strides and storage size. Runtime extents are
+ * taken from `runtime` in order, one per DYNAMIC_EXTENT.
+ */
+template <typename T, GridLayout Layout, size_t... Extents, typename... Sizes>
+GridView<T, Layout, Extents...> &init_grid_view(GridView<T, Layout, Extents...> &view, T *data, Sizes... runtime)
+{
+    typedef GridView<T, Layout, Extents...> View;
+    const size_t given[sizeof...(Sizes) + 1] = {(size_t) runtime..., 0};
+    int dynamic = 0;
+    for (int d = 0; d < View::N; ++d)
+    {
+        if (View::static_extent[d] == DYNAMIC_EXTENT) ++dynamic;
+    }
+    if (dynamic != (int) sizeof...(Sizes))
+        throw std::invalid_argument("expected " + std::to_string(dynamic) + " runtime extents");
+
+    view.data = data;
+    for (int d = 0, r = 0; d < View::N; ++d)
+        view.extent[d] = (View::static_extent[d] != DYNAMIC_EXTENT) ? View::static_extent[d] : given[r++];
+
+    // TILED_Z strides count whole tiles
+    size_t span[View::N];
+    for (int d = 0; d < View::N; ++d)
+        span[d] = (Layout == TILED_Z) ? (view.extent[d] + GRID_TILE - 1) / GRID_TILE : view.extent[d];
+
+    size_t s = 1;
+    if (Layout == COLUMN_MAJOR)
+    {
+        for (int d = 0; d < View::N; ++d) { view.stride[d] = s; s *= span[d]; }
+    }
+    else
+    {
+        for (int d = View::N - 1; d >= 0; --d) { view.stride[d] = s; s *= span[d]; }
+    }
+    view.storage = (Layout == TILED_Z) ? s * View::tile_items() : s;
+    return view;
+}
+
+/**
+ * Make a view over `data`; pass one size per DYNAMIC_EXTENT
+ */
+template <typename T, GridLayout Layout, size_t... Extents, typename... Sizes>
+GridView<T, Layout, Extents...> make_grid_view(T *data, Sizes... runtime)
+{
+    GridView<T, Layout, Extents...> view;
+    init_grid_view(view, data, runtime...);
+    return view;
+}
+
+/**
+ * Storage a fully static row- or column-major grid needs, as a constant
+ * (for sizing plain arrays)
+ */
+template <size_t... Extents>
+constexpr size_t grid_items()
+{
+    static_assert(((Extents != DYNAMIC_EXTENT) && ...), "every extent must be static");
+    return (Extents * ...);
+}
+
+#endif
@@ -0,0 +1,161 @@
+// build: clang++ ledger_bench.cpp -std=c++17 -O2 -pthread -o ledger_bench
+#include "account.h"
+#include "ledger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+  #include <io.h>
+  #define NULL_DEVICE "NUL"
+  static int dup_fd(int fd) { return _dup(fd); }
+  static int dup2_fd(int from, int to) { return _dup2(from, to); }
+  static int close_fd(int fd) { return _close(fd); }
+  static int file_fd(FILE *f) { return _fileno(f); }
+#else
+  #include <unistd.h>
+  #define NULL_DEVICE "/dev/null"
+  static int dup_fd(int fd) { return dup(fd); }
+  static int dup2_fd(int from, int to) { return dup2(from, to); }
+  static int close_fd(int fd) { return close(fd); }
+  static int file_fd(FILE *f) { return fileno(f); }
+#endif
+
+// Throughput: the same batches through the Account classes (one heap
+// object per account, a virtual withdraw, printf per rejection) and through
+// the batch Ledger. Balances are compared bit for bit at the end.
+//
+// usage: ./ledger_bench [accounts] [operations per batch] [batches] [threads]
+
+/**
+ * Seconds since an earlier steady_clock reading
+ */
+static double seconds_since(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * Run the batch through objects[], as calling code using account.h would.
+ * stdout goes to the null device meanwhile, so the rejection printf calls
+ * still cost what they cost without flooding the terminal.
+ */
+static void apply_objects(std::vector<Account *> &objects, const std::vector<uint8_t> &type,
+                          const std::vector<uint32_t> &object_of, const std::vector<Transaction> &batch)
+{
+    fflush(stdout);
+    int saved = dup_fd(file_fd(stdout));
+    FILE *null_out = fopen(NULL_DEVICE, "w");
+    if (null_out) dup2_fd(file_fd(null_out), file_fd(stdout));
+
+    for (const Transaction &t : batch)
+    {
+        uint32_t k = object_of[t.account];
+        Account *a = objects[k];
+        if (t.op == OP_DEPOSIT) a->deposit(t.amount);
+        else if (t.op == OP_WITHDRAW) a->withdraw(t.amount);
+        else if (type[k] == SAVINGS_ACCOUNT) static_cast<SavingsAccount *>(a)->add_interest();
+    }
+
+    fflush(stdout);
+    if (null_out) fclose(null_out);
+    if (saved >= 0)
+    {
+        dup2_fd(saved, file_fd(stdout));
+        close_fd(saved);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t accounts = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t ops = argc > 2 ? strtoul(argv[2], nullptr, 10) : 10000000;
+    int batches = argc > 3 ? atoi(argv[3]) : 3;
+    unsigned threads = argc > 4 ? (unsigned)atoi(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+    if (accounts == 0 || ops == 0 || batches <= 0)
+    {
+        printf("usage: %s [accounts] [operations per batch] [batches] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    // the same accounts both ways: objects in creation order, ledger ids next to them
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> opening(0, 500), rate(0.01, 0.05), amount(1, 120);
+    Ledger ledger;
+    init_ledger(ledger, threads);
+    std::vector<Account *> objects;
+    std::vector<uint8_t> type;
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> object_of; // account id -> object index
+    for (size_t k = 0; k < accounts; k++)
+    {
+        std::string name = "acct" + std::to_string(k);
+        double b = opening(rng);
+        uint32_t id;
+        if (rng() & 1)
+        {
+            double r = rate(rng);
+            objects.push_back(new SavingsAccount(name, b, r));
+            id = open_account(ledger, SAVINGS_ACCOUNT, name, b, r);
+        }
+        else
+        {
+            objects.push_back(new NormalAccount(name, b));
+            id = open_account(ledger, NORMAL_ACCOUNT, name, b);
+        }
+        type.push_back(account_type(id));
+        ids.push_back(id);
+        if (object_of.size() <= id) object_of.resize((size_t)id + 1);
+        object_of[id] = (uint32_t)k;
+    }
+
+    // 45% deposits, 50% withdrawals (some overdraw), 5% interest on savings accounts
+    std::vector<std::vector<Transaction>> work(batches);
+    for (std::vector<Transaction> &batch : work)
+    {
+        batch.resize(ops);
+        for (Transaction &t : batch)
+        {
+            uint32_t k = (uint32_t)(rng() % accounts);
+            unsigned roll = rng() % 100;
+            t.account = ids[k];
+            t.amount = amount(rng);
+            t.op = roll < 45 ? OP_DEPOSIT : roll < 95 ? OP_WITHDRAW : OP_ADD_INTEREST;
+            if (t.op == OP_ADD_INTEREST && type[k] != SAVINGS_ACCOUNT) t.op = OP_DEPOSIT;
+        }
+    }
+    printf("%zu accounts, %d batches of %zu operations, %u threads\n", accounts, batches, ops, threads);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const std::vector<Transaction> &batch : work) apply_objects(objects, type, object_of, batch);
+    double object_s = seconds_since(t0);
+
+    BatchReport last;
+    size_t rejected = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (const std::vector<Transaction> &batch : work)
+    {
+        last = apply_batch(ledger, batch);
+        rejected += last.rejected.size();
+    }
+    double ledger_s = seconds_since(t0);
+
+    size_t mismatched = 0;
+    for (size_t k = 0; k < accounts; k++)
+        if (objects[k]->get_balance() != get_balance(ledger, ids[k])) mismatched++;
+
+    double total = (double)ops * batches;
+    printf("objects  %8.3f s  %7.2f M ops/s\n", object_s, total / object_s / 1e6);
+    printf("ledger   %8.3f s  %7.2f M ops/s  (%.1fx)\n", ledger_s, total / ledger_s / 1e6, object_s / ledger_s);
+    printf("rejected %zu operations over all batches, balances mismatched: %zu\n", rejected, mismatched);
+    printf("last batch: ");
+    print_batch_report(last, 5);
+
+    for (Account *a : objects) delete a;
+    return mismatched ? 1 : 0;
+}
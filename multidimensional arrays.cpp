@@ -1,4 +1,5 @@
 #include "splashkit.h"
+#include "grid_view.h"
 #include <cstdio>   // For printf and scanf
 
 // Define the dimensions of the grid
@@ -6,6 +7,11 @@ const int MAX_GRID = 2;   // Number of grids (like layers)
 const int MAX_COL  = 3;   // Number of columns in each grid
 const int MAX_ROW  = 4;   // Number of rows in each column
 
+// The grid as a view over a flat buffer: (grid, column, row), row index
+// fastest. The extents are compile-time constants, so are the strides.
+typedef GridView<int, ROW_MAJOR, MAX_GRID, MAX_COL, MAX_ROW> grid_view;
+const grid_view GRID_SHAPE = make_grid_view<int, ROW_MAJOR, MAX_GRID, MAX_COL, MAX_ROW>((int *) NULL);
+
 // ------------------------------------------------------------
 // Converts a 3D index (grid, column, row) into a 1D array index.
 // Returns -1 if the indices are out of valid range.
@@ -13,17 +19,13 @@ const int MAX_ROW  = 4;   // Number of rows in each column
 int grid_data_index(int grid_index, int column_index, int row_index)
 {
     // Check if any index is out of bounds
-    if ( grid_index < 0 || grid_index >= MAX_GRID ||
-         column_index < 0 || column_index >= MAX_COL ||
-         row_index < 0 || row_index >= MAX_ROW )
+    if ( !GRID_SHAPE.in_bounds(grid_index, column_index, row_index) )
     {
         return -1; // Invalid index
     }
 
     // Calculate the 1D index from the 3D coordinates
-    return grid_index * (MAX_COL * MAX_ROW) +
-           column_index * MAX_ROW +
-           row_index;
+    return (int) GRID_SHAPE.index(grid_index, column_index, row_index);
 }
 
 // ------------------------------------------------------------
@@ -68,7 +70,8 @@ int main()
 
     // Create a 1D array to store all grid data
     // Total size = MAX_GRID * MAX_COL * MAX_ROW
-    int grid[MAX_GRID * MAX_COL * MAX_ROW] = {0}; // Initialize all to 0
+    int grid[grid_items<MAX_GRID, MAX_COL, MAX_ROW>()] = {0}; // Initialize all to 0
+    grid_view view = make_grid_view<int, ROW_MAJOR, MAX_GRID, MAX_COL, MAX_ROW>(grid);
 
     // Set some example values in the grid
     set_grid_data(grid, 0, 0, 0, 10); // grid 0, col 0, row 0 = 10
@@ -80,19 +83,15 @@ int main()
     printf("grid[0][1][2] = %d\n", read_grid_data(grid, 0, 1, 2));
     printf("grid[1][2][3] = %d\n", read_grid_data(grid, 1, 2, 3));
 
-    // Loop through all positions and print their values
+    // Loop through all positions and print their values. for_each walks
+    // the buffer in storage order, so there is no index maths or bounds
+    // check per cell.
     printf("\n--- Full Grid Data ---\n");
-    for (int g = 0; g < MAX_GRID; g++)
+    view.for_each([](int value, const size_t (&pos)[3])
     {
-        for (int c = 0; c < MAX_COL; c++)
-        {
-            for (int r = 0; r < MAX_ROW; r++)
-            {
-                printf("grid[%d][%d][%d] = %d\n",
-                       g, c, r, read_grid_data(grid, g, c, r));
-            }
-        }
-    }
+        printf("grid[%d][%d][%d] = %d\n",
+               (int) pos[0], (int) pos[1], (int) pos[2], value);
+    });
 
     // Keep the window open for 5 seconds before closing
     delay(5000);
@@ -1,23 +1,51 @@
 #include "splashkit.h"
 #include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
 
-#define MAX_ROCKS 100
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define ROCK_SSE2 1
+#endif
+
+#define DEFAULT_MAX_ROCKS 20000   // rock budget, override with the first command-line argument
+#define DEFAULT_SPAWN_BURST 1     // rocks per spawn, override with the second argument
+#define GRID_COLUMN_WIDTH 64      // broad-phase column width in pixels
 #define PLAYER_SIZE 20
 #define PLAYER_SPEED 3
 
-// Structure to store data for a single rock
-struct rock_data
+// All rocks, structure-of-arrays: rock i is x[i], y[i], size[i], speed[i].
+// Keeping each field contiguous lets update and collision code stream
+// through only the floats they need, four rocks per SSE2 instruction.
+struct rock_store
+{
+    std::vector<float> x, y;    // Positions of the rocks
+    std::vector<float> size;    // Radii of the rocks
+    std::vector<float> speed;   // Falling speeds
+    int count;                  // Live rocks, always packed at the front
+};
+
+// Broad phase: the screen split into vertical columns, every rock listed in
+// each column its circle overlaps. Rebuilt every frame as a flat array:
+// column c holds ids[start[c]] .. ids[start[c + 1] - 1].
+struct rock_grid
 {
-    double x, y;     // Position of the rock
-    double size;     // Radius of the rock
-    double speed;    // Falling speed
+    int column_count;           // Columns covering the screen width
+    std::vector<int> start;     // column_count + 1 offsets into ids
+    std::vector<int> ids;       // Rock indices grouped by column
+    std::vector<int> cursor;    // Per-column write positions (scratch)
+    std::vector<int> hits;      // Rocks hit this frame (scratch)
+    std::vector<float> cx, cy, cr; // Candidates gathered for the narrow phase (scratch)
 };
 
 // Structure to store all game state data
 struct game_data
 {
-    rock_data rocks[MAX_ROCKS]; // Array of rocks
-    int rock_count;             // Current number of rocks
+    rock_store rocks;           // Live rocks
+    int max_rocks;              // Rock budget
+    int spawn_burst;            // Rocks added per spawn
+    rock_grid grid;             // Broad phase for check_collisions
     double player_x, player_y;  // Player position
     int score;                  // Player score
     int lives;                  // Remaining lives
@@ -27,11 +55,18 @@ struct game_data
 /**
  * Initializes the game state before starting the main loop.
  * Sets player position, score, lives, and schedules the first rock spawn.
- * Resets rock count to zero so no rocks are present at the start.
+ * Sizes the rock arrays to the budget up front so spawning never reallocates.
  */
-void init_game(game_data &game)
+void init_game(game_data &game, int max_rocks, int spawn_burst)
 {
-    game.rock_count = 0;
+    game.rocks.x.assign(max_rocks, 0.0f);
+    game.rocks.y.assign(max_rocks, 0.0f);
+    game.rocks.size.assign(max_rocks, 0.0f);
+    game.rocks.speed.assign(max_rocks, 0.0f);
+    game.rocks.count = 0;
+    game.max_rocks = max_rocks;
+    game.spawn_burst = spawn_burst;
+    game.grid.column_count = screen_width() / GRID_COLUMN_WIDTH + 1;
     game.score = 0;
     game.lives = 3;
     game.player_x = screen_width() / 2;
@@ -40,72 +75,206 @@ void init_game(game_data &game)
 }
 
 /**
- * Creates and adds a new rock to the game if capacity allows.
- * Randomizes size, position, and falling speed, then increments score.
+ * Creates and adds spawn_burst new rocks to the game while capacity allows.
+ * Randomizes size, position, and falling speed, then increments score per rock.
  * Updates the next rock spawn time to a random interval in the future.
  */
 void add_rock(game_data &game)
 {
-    if (game.rock_count >= MAX_ROCKS) return;
-
-    rock_data r;
-    r.size = rnd(20, 200);
-    r.x = rnd(0, screen_width());
-    r.y = -r.size;
-    r.speed = rnd(1, 5);
-
-    game.rocks[game.rock_count] = r;
-    game.rock_count++;
-    game.score += 1;
+    rock_store &rs = game.rocks;
+    for (int n = 0; n < game.spawn_burst && rs.count < game.max_rocks; n++)
+    {
+        int i = rs.count++;
+        rs.size[i] = (float)rnd(20, 200);
+        rs.x[i] = (float)rnd(0, screen_width());
+        rs.y[i] = -rs.size[i];
+        rs.speed[i] = (float)rnd(1, 5);
+        game.score += 1;
+    }
     game.next_rock_time = current_ticks() + rnd(1000, 6000);
 }
 
+/**
+ * Copies rock `from` into slot `to` (to <= from) during compaction.
+ */
+inline void move_rock(rock_store &rs, int to, int from)
+{
+    rs.x[to] = rs.x[from];
+    rs.y[to] = rs.y[from];
+    rs.size[to] = rs.size[from];
+    rs.speed[to] = rs.speed[from];
+}
+
 /**
  * Updates the vertical position of all rocks each frame.
  * Removes rocks that move off-screen and awards points based on their size.
- * Uses O(1) removal by replacing removed rock with the last rock in the array.
+ * One pass moves every rock, tests it against the bottom edge and compacts the
+ * survivors in order; sizes of the dropped rocks are summed in the same pass.
  */
 void update_rocks(game_data &game)
 {
-    for (int i = 0; i < game.rock_count; )
+    rock_store &rs = game.rocks;
+    const float height = (float)screen_height();
+    float *x = rs.x.data(), *y = rs.y.data(), *size = rs.size.data(), *speed = rs.speed.data();
+    const int n = rs.count;
+    int i = 0, w = 0;           // read and write positions
+    float dropped = 0.0f;       // sizes are whole numbers, so the float sum is exact
+
+#ifdef ROCK_SSE2
+    const __m128 h = _mm_set1_ps(height);
+    __m128 dropped4 = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4)
     {
-        game.rocks[i].y += game.rocks[i].speed;
+        __m128 yv = _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(speed + i));
+        __m128 sv = _mm_loadu_ps(size + i);
+        __m128 off = _mm_cmpgt_ps(_mm_sub_ps(yv, sv), h);
+        dropped4 = _mm_add_ps(dropped4, _mm_and_ps(off, sv));
+        _mm_storeu_ps(y + i, yv);
 
-        if (game.rocks[i].y - game.rocks[i].size > screen_height())
+        int mask = _mm_movemask_ps(off);
+        if (mask == 0)
         {
-            game.score += (int)game.rocks[i].size;
-            game.rocks[i] = game.rocks[game.rock_count - 1];
-            game.rock_count--;
+            if (w != i)         // all four stay: shift them down as a block
+            {
+                _mm_storeu_ps(x + w, _mm_loadu_ps(x + i));
+                _mm_storeu_ps(y + w, yv);
+                _mm_storeu_ps(size + w, sv);
+                _mm_storeu_ps(speed + w, _mm_loadu_ps(speed + i));
+            }
+            w += 4;
+            continue;
         }
-        else
+        for (int k = 0; k < 4; k++)
         {
-            i++;
+            if (mask >> k & 1) continue;
+            if (w != i + k) move_rock(rs, w, i + k);
+            w++;
         }
     }
+    float lanes[4];
+    _mm_storeu_ps(lanes, dropped4);
+    dropped += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+    for (; i < n; i++)          // scalar tail, or the whole array without SSE2
+    {
+        y[i] += speed[i];
+        bool off = y[i] - size[i] > height;
+        dropped += off ? size[i] : 0.0f;
+        if (off) continue;
+        if (w != i) move_rock(rs, w, i);
+        w++;
+    }
+
+    rs.count = w;
+    game.score += (int)dropped;
+}
+
+/**
+ * Finds the range of grid columns overlapped by the span [x0, x1].
+ * Clamps to the screen so rocks hanging over an edge land in the edge column.
+ */
+void grid_columns(const rock_grid &grid, double x0, double x1, int &c0, int &c1)
+{
+    c0 = std::max(0, std::min(grid.column_count - 1, (int)(x0 / GRID_COLUMN_WIDTH)));
+    c1 = std::max(0, std::min(grid.column_count - 1, (int)(x1 / GRID_COLUMN_WIDTH)));
+}
+
+/**
+ * Rebuilds the column grid from the current rock positions.
+ * Counts rocks per column, turns the counts into offsets, then fills the ids.
+ * Two passes over the rocks and no allocation once the vectors have grown.
+ */
+void build_rock_grid(game_data &game)
+{
+    rock_grid &grid = game.grid;
+    const rock_store &rs = game.rocks;
+    grid.start.assign(grid.column_count + 1, 0);
+
+    int c0, c1;
+    for (int i = 0; i < rs.count; i++)
+    {
+        grid_columns(grid, rs.x[i] - rs.size[i], rs.x[i] + rs.size[i], c0, c1);
+        for (int c = c0; c <= c1; c++) grid.start[c + 1]++;
+    }
+    for (int c = 0; c < grid.column_count; c++) grid.start[c + 1] += grid.start[c];
+
+    grid.ids.resize(grid.start[grid.column_count]);
+    grid.cursor.assign(grid.start.begin(), grid.start.end() - 1);
+    for (int i = 0; i < rs.count; i++)
+    {
+        grid_columns(grid, rs.x[i] - rs.size[i], rs.x[i] + rs.size[i], c0, c1);
+        for (int c = c0; c <= c1; c++) grid.ids[grid.cursor[c]++] = i;
+    }
+}
+
+/**
+ * Narrow phase over n gathered candidates: appends the position k of every
+ * circle (x[k], y[k], r[k]) that intersects the circle (px, py, pr) to hits.
+ * Same test as circles_intersect, distance below the sum of the radii.
+ */
+void circle_hits(const float *x, const float *y, const float *r, int n,
+                 float px, float py, float pr, std::vector<int> &hits)
+{
+    int k = 0;
+#ifdef ROCK_SSE2
+    const __m128 pxv = _mm_set1_ps(px), pyv = _mm_set1_ps(py), prv = _mm_set1_ps(pr);
+    for (; k + 4 <= n; k += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + k), pxv);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + k), pyv);
+        __m128 rr = _mm_add_ps(_mm_loadu_ps(r + k), prv);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(d2, _mm_mul_ps(rr, rr)));
+        // four lanes: a plain bit loop instead of __builtin_ctz, which MSVC lacks
+        if (mask)
+            for (int lane = 0; lane < 4; lane++)
+                if (mask & (1 << lane)) hits.push_back(k + lane);
+    }
+#endif
+    for (; k < n; k++)
+    {
+        float dx = x[k] - px, dy = y[k] - py, rr = r[k] + pr;
+        if (dx * dx + dy * dy < rr * rr) hits.push_back(k);
+    }
 }
 
 /**
  * Checks for collisions between the player and any rock.
  * If a collision occurs, removes the rock and decreases player lives by one.
- * Uses circle-based collision detection for simplicity and efficiency.
+ * Only rocks in the player's grid columns are gathered into packed arrays,
+ * then circle_hits tests them four at a time.
  */
 void check_collisions(game_data &game)
 {
-    circle player_circle = circle_at(point_2d{game.player_x, game.player_y}, PLAYER_SIZE);
+    build_rock_grid(game);
+    rock_grid &grid = game.grid;
+    rock_store &rs = game.rocks;
 
-    for (int i = 0; i < game.rock_count; )
+    int q0, q1;
+    grid_columns(grid, game.player_x - PLAYER_SIZE, game.player_x + PLAYER_SIZE, q0, q1);
+    const int first = grid.start[q0], last = grid.start[q1 + 1];
+    const int n = last - first;
+    grid.cx.resize(n); grid.cy.resize(n); grid.cr.resize(n);
+    for (int k = 0; k < n; k++)
     {
-        circle rock_circle = circle_at(point_2d{game.rocks[i].x, game.rocks[i].y}, game.rocks[i].size);
-        if (circles_intersect(player_circle, rock_circle))
-        {
-            game.lives--;
-            game.rocks[i] = game.rocks[game.rock_count - 1];
-            game.rock_count--;
-        }
-        else
-        {
-            i++;
-        }
+        int i = grid.ids[first + k];
+        grid.cx[k] = rs.x[i]; grid.cy[k] = rs.y[i]; grid.cr[k] = rs.size[i];
+    }
+
+    grid.hits.clear();
+    circle_hits(grid.cx.data(), grid.cy.data(), grid.cr.data(), n,
+                (float)game.player_x, (float)game.player_y, (float)PLAYER_SIZE, grid.hits);
+    for (int &h : grid.hits) h = grid.ids[first + h];
+
+    // a rock spanning both player columns is listed twice; then swap-remove
+    // from the highest index down so pending indices stay valid
+    std::sort(grid.hits.begin(), grid.hits.end(), [](int a, int b) { return a > b; });
+    grid.hits.erase(std::unique(grid.hits.begin(), grid.hits.end()), grid.hits.end());
+    for (int i : grid.hits)
+    {
+        game.lives--;
+        move_rock(rs, i, --rs.count);
     }
 }
 
@@ -137,19 +306,24 @@ void draw_game(const game_data &game)
 
     fill_circle(COLOR_BLUE, game.player_x, game.player_y, PLAYER_SIZE);
 
-    for (int i = 0; i < game.rock_count; i++)
+    const rock_store &rs = game.rocks;
+    for (int i = 0; i < rs.count; i++)
     {
-        fill_circle(COLOR_GRAY, game.rocks[i].x, game.rocks[i].y, game.rocks[i].size);
+        fill_circle(COLOR_GRAY, rs.x[i], rs.y[i], rs.size[i]);
     }
 
     refresh_screen();
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+    // optional: rock_dodge [max_rocks] [rocks_per_spawn]
+    int max_rocks = argc > 1 ? std::max(1, atoi(argv[1])) : DEFAULT_MAX_ROCKS;
+    int spawn_burst = argc > 2 ? std::max(1, atoi(argv[2])) : DEFAULT_SPAWN_BURST;
+
     open_window("Rock Dodge Game", 800, 600);
     game_data game;
-    init_game(game);
+    init_game(game, max_rocks, spawn_burst);
 
     while (!quit_requested() && game.lives > 0)
     {